@@ -195,9 +195,28 @@ public:
 
         wxpex::RegisterWidgetName(weapons1, "weapons1");
 
+        // The content of this pane is not created until it is expanded.
+        auto weapons2 = new wxpex::Collapsible(this, "Weapons (lazy)");
+
+        weapons2->SetContentFactory(
+            [control](wxWindow *panel) -> std::unique_ptr<wxSizer>
+            {
+                auto weaponsView =
+                    new WeaponsView(
+                        panel,
+                        "Weapons View",
+                        control.thing2.weapons,
+                        wxpex::LayoutOptions{});
+
+                return wxpex::LayoutItems(wxpex::verticalItems, weaponsView);
+            });
+
+        wxpex::RegisterWidgetName(weapons2, "weapons2");
+
         auto sizer = wxpex::LayoutItems(
             wxpex::verticalItems,
-            weapons1);
+            weapons1,
+            weapons2);
 
         this->SetSizer(sizer.release());
     }
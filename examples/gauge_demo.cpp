@@ -201,7 +201,14 @@ ExampleFrame::ExampleFrame(DemoControl demoControl)
     using namespace wxpex;
 
     auto gauge1 = new Gauge(this, demoControl.gauge1);
-    auto gauge2 = new ValueGauge(this, demoControl.gauge2);
+
+    // gauge2 is updated at 100 Hz. Limit the readout to 30 Hz, and display
+    // the range of values that were skipped.
+    auto gauge2 = new ValueGauge(
+        this,
+        demoControl.gauge2,
+        ReadoutSettings().MaximumRate(30).ShowExtrema(true));
+
     auto startButton = new Button(this, "Start", demoControl.start);
     auto stopButton = new Button(this, "Stop", demoControl.stop);
 
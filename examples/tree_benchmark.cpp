@@ -0,0 +1,665 @@
+/**
+  * @file tree_benchmark.cpp
+  *
+  * @brief Measures how construction, layout, and teardown scale with the
+  * size of a generated widget tree.
+  *
+  * Usage:
+  *
+  *     tree_benchmark [--collapsibles=N] [--widgets=M] [--rows=K]
+  *         [--depth=D] [--steps=S] [--ratio=R] [--profile]
+  *
+  * N collapsibles are generated, nested D deep. Each holds M sliders, M knobs,
+  * and M fields connected to one member of a pex::List. A ListView shows K
+  * rows from a second list.
+  *
+  * The tree is built S times (default 4), doubling N and K each time. When
+  * the time to build, lay out, and destroy the tree grows by more than R
+  * (default 3) from one size to the next, the benchmark exits with a failure
+  * status, so it can guard against super-linear regressions. With --profile,
+  * the startup profile of the largest tree is written.
+  *
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fields/fields.h>
+#include <pex/group.h>
+#include <pex/list.h>
+#include <pex/range.h>
+
+#include <wxpex/collapsible.h>
+#include <wxpex/field.h>
+#include <wxpex/knob.h>
+#include <wxpex/layout_items.h>
+#include <wxpex/list_view.h>
+#include <wxpex/scrolled.h>
+#include <wxpex/slider.h>
+#include <wxpex/startup_profiler.h>
+#include <wxpex/view.h>
+#include <wxpex/widget_names.h>
+
+
+using pex::Limit;
+using pex::MakeRange;
+
+
+template<typename T>
+struct ChannelFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::level, "level"),
+        fields::Field(&T::balance, "balance"),
+        fields::Field(&T::offset, "offset"));
+};
+
+
+template<template<typename> typename T>
+struct ChannelTemplate
+{
+    T<MakeRange<double, Limit<0>, Limit<100>>> level;
+    T<MakeRange<double, Limit<-1>, Limit<1>>> balance;
+    T<double> offset;
+
+    static constexpr auto fields = ChannelFields<ChannelTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Channel";
+};
+
+
+using ChannelGroup = pex::Group<ChannelFields, ChannelTemplate>;
+using ChannelControl = typename ChannelGroup::Control;
+
+
+template<typename T>
+struct RowFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::name, "name"),
+        fields::Field(&T::value, "value"));
+};
+
+
+template<template<typename> typename T>
+struct RowTemplate
+{
+    T<std::string> name;
+    T<MakeRange<int, Limit<0>, Limit<1000>>> value;
+
+    static constexpr auto fields = RowFields<RowTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Row";
+};
+
+
+using RowGroup = pex::Group<RowFields, RowTemplate>;
+using RowControl = typename RowGroup::Control;
+
+
+using ChannelListMaker = pex::List<ChannelGroup, 0>;
+using RowListMaker = pex::List<RowGroup, 0>;
+
+
+template<typename T>
+struct BenchmarkFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::channels, "channels"),
+        fields::Field(&T::rows, "rows"));
+};
+
+
+template<template<typename> typename T>
+struct BenchmarkTemplate
+{
+    T<ChannelListMaker> channels;
+    T<RowListMaker> rows;
+
+    static constexpr auto fields = BenchmarkFields<BenchmarkTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Benchmark";
+};
+
+
+using BenchmarkGroup = pex::Group<BenchmarkFields, BenchmarkTemplate>;
+using BenchmarkModel = typename BenchmarkGroup::Model;
+using BenchmarkControl = typename BenchmarkGroup::Control;
+
+using ChannelListControl = pex::ControlSelector<ChannelListMaker>;
+using RowListControl = pex::ControlSelector<RowListMaker>;
+
+
+// Parses a whole argument value, rejecting anything that is not a number.
+bool ParseCount(const std::string &text, size_t &result)
+{
+    if (text.empty() || text.find_first_not_of("0123456789") != text.npos)
+    {
+        return false;
+    }
+
+    try
+    {
+        result = std::stoul(text);
+    }
+    catch (const std::out_of_range &)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+bool ParseRatio(const std::string &text, double &result)
+{
+    char *end = nullptr;
+    result = std::strtod(text.c_str(), &end);
+
+    return !text.empty()
+        && end == text.c_str() + text.size()
+        && std::isfinite(result)
+        && result > 1.0;
+}
+
+
+struct BenchmarkSettings
+{
+    size_t collapsibles = 32;
+    size_t widgets = 4;
+    size_t rows = 64;
+    size_t depth = 4;
+    size_t steps = 4;
+    double maximumRatio = 3.0;
+    bool profile = false;
+
+    // Returns false if an argument was not recognized or not valid.
+    bool Parse(const std::vector<std::string> &arguments)
+    {
+        for (auto &argument: arguments)
+        {
+            if (argument == "--profile")
+            {
+                this->profile = true;
+                continue;
+            }
+
+            auto separator = argument.find('=');
+
+            if (separator == std::string::npos)
+            {
+                return false;
+            }
+
+            auto name = argument.substr(0, separator);
+            auto text = argument.substr(separator + 1);
+
+            if (name == "--ratio")
+            {
+                if (!ParseRatio(text, this->maximumRatio))
+                {
+                    return false;
+                }
+
+                continue;
+            }
+
+            size_t value;
+
+            if (!ParseCount(text, value))
+            {
+                return false;
+            }
+
+            if (name == "--collapsibles")
+            {
+                this->collapsibles = value;
+            }
+            else if (name == "--widgets")
+            {
+                this->widgets = value;
+            }
+            else if (name == "--rows")
+            {
+                this->rows = value;
+            }
+            else if (name == "--depth" && value > 0)
+            {
+                this->depth = value;
+            }
+            else if (name == "--steps" && value > 0)
+            {
+                this->steps = value;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // The settings for step, with twice as many collapsibles and rows as the
+    // step before it.
+    BenchmarkSettings GetStep(size_t step) const
+    {
+        auto result = *this;
+        result.collapsibles <<= step;
+        result.rows <<= step;
+
+        return result;
+    }
+};
+
+
+class ChannelView: public wxpex::Collapsible
+{
+public:
+    ChannelView(
+        wxWindow *parent,
+        const std::string &label,
+        ChannelControl control,
+        size_t widgetCount)
+        :
+        wxpex::Collapsible(parent, label, wxBORDER_SIMPLE)
+    {
+        auto panel = this->GetPanel();
+        auto sizer = std::make_unique<wxBoxSizer>(wxVERTICAL);
+
+        for (size_t i = 0; i < widgetCount; ++i)
+        {
+            sizer->Add(
+                wxpex::CreateViewSlider<2>(panel, control.level),
+                0,
+                wxEXPAND | wxBOTTOM,
+                3);
+
+            sizer->Add(
+                wxpex::CreateViewKnob<3>(panel, control.balance),
+                0,
+                wxEXPAND | wxBOTTOM,
+                3);
+
+            sizer->Add(
+                wxpex::CreateField<3>(panel, control.offset),
+                0,
+                wxEXPAND | wxBOTTOM,
+                3);
+        }
+
+        this->sizer_ = sizer.get();
+        this->ConfigureSizer(std::move(sizer));
+        this->Collapse(false);
+    }
+
+    // Nested collapsibles are added after the widgets.
+    void AddChild(wxWindow *child)
+    {
+        this->sizer_->Add(child, 0, wxEXPAND | wxLEFT, 10);
+    }
+
+private:
+    wxSizer *sizer_;
+};
+
+
+class RowView: public wxPanel
+{
+public:
+    RowView(wxWindow *parent, RowControl control)
+        :
+        wxPanel(parent, wxID_ANY)
+    {
+        auto name = wxpex::MakeView(this, control.name);
+        auto value = wxpex::CreateViewSlider<0>(this, control.value);
+
+        this->SetSizer(
+            wxpex::LayoutItems(
+                wxpex::horizontalItems,
+                name,
+                value).release());
+    }
+};
+
+
+class RowListView: public wxpex::ListView<RowListControl>
+{
+public:
+    using Base = wxpex::ListView<RowListControl>;
+    using ListItem = typename Base::ListItem;
+
+    RowListView(wxWindow *parent, RowListControl rows)
+        :
+        Base(parent, rows)
+    {
+        // The rows already exist, so create their views now.
+        this->Initialize_();
+    }
+
+protected:
+    wxWindow * CreateView_(ListItem &itemControl, size_t) override
+    {
+        auto result = new RowView(this, itemControl);
+        wxpex::RegisterWidgetName(result, "RowView");
+
+        return result;
+    }
+};
+
+
+class BenchmarkView: public wxpex::Scrolled
+{
+public:
+    BenchmarkView(
+        wxWindow *parent,
+        BenchmarkControl control,
+        const BenchmarkSettings &settings)
+        :
+        wxpex::Scrolled(parent),
+        deepestLeaf_(nullptr)
+    {
+        auto sizer = std::make_unique<wxBoxSizer>(wxVERTICAL);
+
+        // Each chain of collapsibles is settings.depth deep. The last
+        // collapsible created is the deepest leaf of the last chain.
+        ChannelView *chainParent = nullptr;
+        size_t index = 0;
+
+        for (auto &channel: ChannelListControl(control.channels))
+        {
+            bool startsChain = (index % settings.depth) == 0;
+
+            wxWindow *parent =
+                startsChain
+                ? static_cast<wxWindow *>(this)
+                : chainParent->GetPanel();
+
+            auto view = new ChannelView(
+                parent,
+                "Channel " + std::to_string(index),
+                channel,
+                settings.widgets);
+
+            wxpex::RegisterWidgetName(view, "ChannelView");
+
+            if (startsChain)
+            {
+                sizer->Add(view, 0, wxEXPAND | wxBOTTOM, 3);
+            }
+            else
+            {
+                chainParent->AddChild(view);
+            }
+
+            chainParent = view;
+            this->deepestLeaf_ = view;
+            ++index;
+        }
+
+        auto rows = new RowListView(this, control.rows);
+        wxpex::RegisterWidgetName(rows, "RowListView");
+        sizer->Add(rows, 0, wxEXPAND);
+
+        this->ConfigureSizer(wxpex::verticalScrolled, std::move(sizer));
+    }
+
+    wxpex::Collapsible * GetDeepestLeaf()
+    {
+        return this->deepestLeaf_;
+    }
+
+private:
+    wxpex::Collapsible *deepestLeaf_;
+};
+
+
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+
+size_t CountWindows(wxWindow *window)
+{
+    size_t result = 1;
+
+    for (auto child: window->GetChildren())
+    {
+        result += CountWindows(child);
+    }
+
+    return result;
+}
+
+
+template<typename Function>
+double Time_ms(Function &&function)
+{
+    auto start = Clock::now();
+    function();
+
+    return Milliseconds(Clock::now() - start).count();
+}
+
+
+struct Timings
+{
+    size_t windowCount = 0;
+    double construction_ms = 0.0;
+    double layout_ms = 0.0;
+    double fixLayout_ms = 0.0;
+    double update_ms = 0.0;
+    double destruction_ms = 0.0;
+
+    // The phases that scale with the size of the tree.
+    double GetTotal_ms() const
+    {
+        return this->construction_ms + this->layout_ms + this->destruction_ms;
+    }
+};
+
+
+class BenchmarkApp: public wxApp
+{
+public:
+    BenchmarkApp()
+        :
+        model_(),
+        settings_()
+    {
+
+    }
+
+    bool OnInit() override;
+
+    int OnRun() override;
+
+private:
+    Timings Run_(const BenchmarkSettings &settings, bool profile);
+
+    BenchmarkModel model_;
+    BenchmarkSettings settings_;
+};
+
+
+// Creates the main function for us, and initializes the app's run loop.
+wxshimIMPLEMENT_APP(BenchmarkApp)
+
+
+bool BenchmarkApp::OnInit()
+{
+    std::vector<std::string> arguments;
+
+    for (int i = 1; i < this->argc; ++i)
+    {
+        arguments.push_back(this->argv[i].ToStdString());
+    }
+
+    if (!this->settings_.Parse(arguments))
+    {
+        std::cerr << "Usage: tree_benchmark [--collapsibles=N] [--widgets=M] "
+            "[--rows=K] [--depth=D] [--steps=S] [--ratio=R] [--profile]"
+            << std::endl;
+
+        // wxWidgets exits with a failure status.
+        return false;
+    }
+
+    return true;
+}
+
+
+int BenchmarkApp::OnRun()
+{
+    // Every run happens here, so the event loop is never entered.
+    std::cout << "widgets: " << this->settings_.widgets
+        << ", depth: " << this->settings_.depth << '\n';
+
+    std::cout << std::fixed << std::setprecision(3)
+        << std::setw(13) << "collapsibles"
+        << std::setw(8) << "rows"
+        << std::setw(10) << "windows"
+        << std::setw(14) << "construction"
+        << std::setw(14) << "layout"
+        << std::setw(14) << "fix layout"
+        << std::setw(14) << "update"
+        << std::setw(14) << "destruction"
+        << std::setw(10) << "growth" << " (ms)\n";
+
+    std::optional<double> previousTotal_ms;
+    bool isSuperLinear = false;
+
+    for (size_t step = 0; step < this->settings_.steps; ++step)
+    {
+        auto isLast = (step + 1 == this->settings_.steps);
+        auto stepSettings = this->settings_.GetStep(step);
+
+        auto timings = this->Run_(
+            stepSettings,
+            this->settings_.profile && isLast);
+
+        std::cout << std::setw(13) << stepSettings.collapsibles
+            << std::setw(8) << stepSettings.rows
+            << std::setw(10) << timings.windowCount
+            << std::setw(14) << timings.construction_ms
+            << std::setw(14) << timings.layout_ms
+            << std::setw(14) << timings.fixLayout_ms
+            << std::setw(14) << timings.update_ms
+            << std::setw(14) << timings.destruction_ms;
+
+        auto total_ms = timings.GetTotal_ms();
+
+        if (previousTotal_ms && *previousTotal_ms > 0.0)
+        {
+            // Doubling the tree should about double the time.
+            auto ratio = total_ms / *previousTotal_ms;
+            std::cout << std::setw(10) << ratio;
+
+            if (ratio > this->settings_.maximumRatio)
+            {
+                std::cout << "  exceeds " << this->settings_.maximumRatio;
+                isSuperLinear = true;
+            }
+        }
+
+        std::cout << std::endl;
+        previousTotal_ms = total_ms;
+    }
+
+    if (isSuperLinear)
+    {
+        std::cerr << "Time grew faster than the allowed ratio." << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+Timings BenchmarkApp::Run_(const BenchmarkSettings &settings, bool profile)
+{
+    auto control = BenchmarkControl(this->model_);
+    control.channels.count.Set(settings.collapsibles);
+    control.rows.count.Set(settings.rows);
+
+    size_t rowIndex = 0;
+
+    for (auto &row: RowListControl(control.rows))
+    {
+        row.name.Set("Row " + std::to_string(rowIndex));
+        row.value.value.Set(static_cast<int>(rowIndex % 1000));
+        ++rowIndex;
+    }
+
+    if (profile)
+    {
+        wxpex::StartupProfiler::Enable();
+    }
+
+    Timings result;
+
+    auto frame = new wxFrame(nullptr, wxID_ANY, "wxpex Tree Benchmark");
+    BenchmarkView *view = nullptr;
+
+    result.construction_ms = Time_ms(
+        [&]() -> void
+        {
+            view = new BenchmarkView(frame, control, settings);
+        });
+
+    result.layout_ms = Time_ms(
+        [&]() -> void
+        {
+            auto sizer = std::make_unique<wxBoxSizer>(wxVERTICAL);
+            sizer->Add(view, 1, wxEXPAND);
+            frame->SetSizerAndFit(sizer.release());
+            frame->Layout();
+        });
+
+    if (view->GetDeepestLeaf())
+    {
+        result.fixLayout_ms = Time_ms(
+            [&]() -> void
+            {
+                view->GetDeepestLeaf()->FixLayout();
+            });
+    }
+
+    // One member of the last channel, observed by settings.widgets sliders.
+    if (settings.collapsibles > 0)
+    {
+        auto channel = control.channels.at(settings.collapsibles - 1);
+
+        result.update_ms = Time_ms(
+            [&]() -> void
+            {
+                channel.level.value.Set(50.0);
+            });
+    }
+
+    if (profile)
+    {
+        wxpex::StartupProfiler::WriteReport(std::cout);
+        wxpex::StartupProfiler::Disable();
+    }
+
+    result.windowCount = CountWindows(frame);
+
+    result.destruction_ms = Time_ms(
+        [&]() -> void
+        {
+            frame->DestroyChildren();
+        });
+
+    frame->Destroy();
+
+    // Without an event loop, destroyed frames are only deleted here.
+    this->DeletePendingObjects();
+
+    return result;
+}
@@ -1,4 +1,5 @@
 #define CATCH_CONFIG_MAIN // This tells the catch header to generate a main
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 
 #include <catch2/catch.hpp>
 
@@ -0,0 +1,284 @@
+#include <catch2/catch.hpp>
+
+#include <wxpex/color_kernels.h>
+
+
+// Every third value of each channel, including 0 and 255.
+static std::vector<wxpex::Rgb8> MakeRgbCube()
+{
+    std::vector<wxpex::Rgb8> result;
+
+    for (int red = 0; red < 256; red += 3)
+    {
+        for (int green = 0; green < 256; green += 3)
+        {
+            for (int blue = 0; blue < 256; blue += 3)
+            {
+                result.push_back(
+                    {{
+                        static_cast<uint8_t>(red),
+                        static_cast<uint8_t>(green),
+                        static_cast<uint8_t>(blue)}});
+            }
+        }
+    }
+
+    return result;
+}
+
+
+static std::vector<wxpex::HsvFloat> MakeHsvGrid()
+{
+    std::vector<wxpex::HsvFloat> result;
+
+    for (int hue = 0; hue <= 3600; hue += 7)
+    {
+        for (int saturation = 0; saturation <= 100; saturation += 5)
+        {
+            for (int value = 0; value <= 100; value += 5)
+            {
+                result.push_back(
+                    {{
+                        static_cast<float>(hue) / 10.0f,
+                        static_cast<float>(saturation) / 100.0f,
+                        static_cast<float>(value) / 100.0f}});
+            }
+        }
+    }
+
+    return result;
+}
+
+
+static bool IsSame(const wxpex::Rgb8 &first, const wxpex::Rgb8 &second)
+{
+    return first.red == second.red
+        && first.green == second.green
+        && first.blue == second.blue;
+}
+
+
+TEST_CASE("RgbToHsv matches tau", "[color_kernels]")
+{
+    auto colors = MakeRgbCube();
+    std::vector<wxpex::HsvFloat> converted(colors.size());
+
+    wxpex::RgbToHsv(colors.data(), converted.data(), colors.size());
+
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < colors.size(); ++i)
+    {
+        auto expected = tau::RgbToHsv<float>(colors[i]);
+
+        mismatches += (converted[i].hue != expected.hue)
+            || (converted[i].saturation != expected.saturation)
+            || (converted[i].value != expected.value);
+    }
+
+    REQUIRE(mismatches == 0);
+}
+
+
+TEST_CASE("HsvToRgb matches tau", "[color_kernels]")
+{
+    auto colors = MakeHsvGrid();
+    std::vector<wxpex::Rgb8> converted(colors.size());
+
+    wxpex::HsvToRgb(colors.data(), converted.data(), colors.size());
+
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < colors.size(); ++i)
+    {
+        auto expected = tau::HsvToRgb<uint8_t, float>(colors[i]);
+        mismatches += !IsSame(converted[i], expected);
+    }
+
+    REQUIRE(mismatches == 0);
+}
+
+
+TEST_CASE("8-bit colors survive a round trip", "[color_kernels]")
+{
+    auto colors = MakeRgbCube();
+    std::vector<wxpex::HsvFloat> hsv(colors.size());
+    std::vector<wxpex::Rgb8> rgb(colors.size());
+
+    wxpex::RgbToHsv(colors.data(), hsv.data(), colors.size());
+    wxpex::HsvToRgb(hsv.data(), rgb.data(), colors.size());
+
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < colors.size(); ++i)
+    {
+        mismatches += !IsSame(colors[i], rgb[i]);
+    }
+
+    REQUIRE(mismatches == 0);
+}
+
+
+TEST_CASE("Threads and packed buffers give the same result", "[color_kernels]")
+{
+    auto colors = MakeRgbCube();
+    auto count = colors.size();
+
+    std::vector<uint8_t> packed;
+    packed.reserve(count * 3);
+
+    for (auto &color: colors)
+    {
+        packed.push_back(color.red);
+        packed.push_back(color.green);
+        packed.push_back(color.blue);
+    }
+
+    auto threadCount = GENERATE(1u, 3u, 8u);
+
+    auto settings = wxpex::ConversionSettings()
+        .ThreadCount(threadCount)
+        .MinimumPerThread(1000);
+
+    std::vector<wxpex::HsvFloat> expected(count);
+    wxpex::RgbToHsv(
+        colors.data(),
+        expected.data(),
+        count,
+        wxpex::ConversionSettings().ThreadCount(1));
+
+    std::vector<wxpex::HsvFloat> converted(count);
+    wxpex::PackedRgbToHsv(packed.data(), converted.data(), count, settings);
+
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        mismatches += (converted[i].hue != expected[i].hue)
+            || (converted[i].saturation != expected[i].saturation)
+            || (converted[i].value != expected[i].value);
+    }
+
+    REQUIRE(mismatches == 0);
+
+    std::vector<uint8_t> roundTrip(count * 3);
+    wxpex::HsvToPackedRgb(converted.data(), roundTrip.data(), count, settings);
+
+    REQUIRE(roundTrip == packed);
+}
+
+
+TEST_CASE("Alpha is scaled to and from 0 to 1", "[color_kernels]")
+{
+    std::vector<wxpex::Rgba8> colors{
+        {{255, 0, 0, 0}},
+        {{0, 255, 0, 128}},
+        {{0, 0, 255, 255}}};
+
+    std::vector<wxpex::HsvaFloat> hsva(colors.size());
+    wxpex::RgbaToHsva(colors.data(), hsva.data(), colors.size());
+
+    REQUIRE(hsva[0].hue == 0.0f);
+    REQUIRE(hsva[1].hue == 120.0f);
+    REQUIRE(hsva[2].hue == 240.0f);
+    REQUIRE(hsva[0].alpha == 0.0f);
+    REQUIRE(hsva[1].alpha == Approx(128.0f / 255.0f));
+    REQUIRE(hsva[2].alpha == 1.0f);
+
+    std::vector<wxpex::Rgba8> rgba(colors.size());
+    wxpex::HsvaToRgba(hsva.data(), rgba.data(), colors.size());
+
+    for (size_t i = 0; i < colors.size(); ++i)
+    {
+        REQUIRE(rgba[i].red == colors[i].red);
+        REQUIRE(rgba[i].green == colors[i].green);
+        REQUIRE(rgba[i].blue == colors[i].blue);
+        REQUIRE(rgba[i].alpha == colors[i].alpha);
+    }
+}
+
+
+TEST_CASE("HsvToImage requires one color per pixel", "[color_kernels]")
+{
+    wxImage image(4, 4);
+    std::vector<wxpex::HsvFloat> colors(15);
+
+    REQUIRE_THROWS_AS(
+        wxpex::HsvToImage(colors, image),
+        std::invalid_argument);
+
+    colors.push_back({{0.0f, 1.0f, 1.0f}});
+    wxpex::HsvToImage(colors, image);
+
+    REQUIRE(image.GetRed(3, 3) == 255);
+    REQUIRE(image.GetGreen(3, 3) == 0);
+    REQUIRE(image.GetBlue(0, 0) == 0);
+}
+
+
+TEST_CASE("Color conversion benchmarks", "[.benchmark]")
+{
+    auto colors = MakeRgbCube();
+    auto count = colors.size();
+
+    std::vector<wxpex::HsvFloat> hsv(count);
+    std::vector<wxpex::Rgb8> rgb(count);
+
+    wxpex::RgbToHsv(colors.data(), hsv.data(), count);
+
+    BENCHMARK("tau::RgbToHsv, one color at a time")
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            hsv[i] = tau::RgbToHsv<float>(colors[i]);
+        }
+
+        return hsv.back().hue;
+    };
+
+    BENCHMARK("RgbToHsv, one thread")
+    {
+        wxpex::RgbToHsv(
+            colors.data(),
+            hsv.data(),
+            count,
+            wxpex::ConversionSettings().ThreadCount(1));
+
+        return hsv.back().hue;
+    };
+
+    BENCHMARK("RgbToHsv")
+    {
+        wxpex::RgbToHsv(colors.data(), hsv.data(), count);
+
+        return hsv.back().hue;
+    };
+
+    BENCHMARK("tau::HsvToRgb, one color at a time")
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            rgb[i] = tau::HsvToRgb<uint8_t, float>(hsv[i]);
+        }
+
+        return rgb.back().red;
+    };
+
+    BENCHMARK("HsvToRgb, one thread")
+    {
+        wxpex::HsvToRgb(
+            hsv.data(),
+            rgb.data(),
+            count,
+            wxpex::ConversionSettings().ThreadCount(1));
+
+        return rgb.back().red;
+    };
+
+    BENCHMARK("HsvToRgb")
+    {
+        wxpex::HsvToRgb(hsv.data(), rgb.data(), count);
+
+        return rgb.back().red;
+    };
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+
+#include <wxpex/color_wheel.h>
+
+
+TEST_CASE("Color wheel points and colors are inverses", "[color_wheel]")
+{
+    auto center = tau::Point2d<double>(100.0, 80.0);
+    auto radius = 50.0;
+
+    auto hue = GENERATE(0.0, 45.0, 90.0, 180.0, 270.0, 359.0);
+    auto saturation = GENERATE(0.25, 0.5, 1.0);
+
+    auto point = wxpex::GetColorWheelPoint(center, radius, {hue, saturation});
+    auto result = wxpex::GetColorWheelHueSaturation(center, radius, point);
+
+    REQUIRE(result.hue == Approx(hue));
+    REQUIRE(result.saturation == Approx(saturation));
+}
+
+
+TEST_CASE("Hue increases counterclockwise from the right", "[color_wheel]")
+{
+    auto center = tau::Point2d<double>(0.0, 0.0);
+
+    auto right = wxpex::GetColorWheelHueSaturation(
+        center,
+        10.0,
+        tau::Point2d<double>(5.0, 0.0));
+
+    // Up is negative y on screen.
+    auto up = wxpex::GetColorWheelHueSaturation(
+        center,
+        10.0,
+        tau::Point2d<double>(0.0, -10.0));
+
+    auto outside = wxpex::GetColorWheelHueSaturation(
+        center,
+        10.0,
+        tau::Point2d<double>(0.0, 30.0));
+
+    REQUIRE(right.hue == Approx(0.0));
+    REQUIRE(right.saturation == Approx(0.5));
+    REQUIRE(up.hue == Approx(90.0));
+    REQUIRE(up.saturation == Approx(1.0));
+    REQUIRE(outside.hue == Approx(270.0));
+    REQUIRE(outside.saturation == Approx(1.0));
+}
+
+
+TEST_CASE("Color wheel image", "[color_wheel]")
+{
+    auto image = wxpex::MakeColorWheelImage(101);
+
+    REQUIRE(image.GetWidth() == 101);
+    REQUIRE(image.HasAlpha());
+
+    // The center is unsaturated.
+    REQUIRE(image.GetRed(50, 50) == 255);
+    REQUIRE(image.GetGreen(50, 50) == 255);
+    REQUIRE(image.GetBlue(50, 50) == 255);
+    REQUIRE(image.GetAlpha(50, 50) == 255);
+
+    // Red is on the right.
+    REQUIRE(image.GetRed(99, 50) == 255);
+    REQUIRE(image.GetGreen(99, 50) < 20);
+    REQUIRE(image.GetBlue(99, 50) < 20);
+
+    // A hue of 90 degrees is at the top.
+    REQUIRE(image.GetGreen(50, 1) == 255);
+    REQUIRE(image.GetRed(50, 1) > 110);
+    REQUIRE(image.GetRed(50, 1) < 150);
+
+    // Outside of the disk is transparent.
+    REQUIRE(image.GetAlpha(0, 0) == 0);
+    REQUIRE(image.GetAlpha(100, 100) == 0);
+
+    REQUIRE_THROWS_AS(wxpex::MakeColorWheelImage(0), std::invalid_argument);
+}
+
+
+TEST_CASE("Color wheel benchmark", "[.benchmark]")
+{
+    BENCHMARK("Render a 512 pixel wheel")
+    {
+        return wxpex::MakeColorWheelImage(512);
+    };
+}
@@ -0,0 +1,211 @@
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <limits>
+#include <wxpex/colormap.h>
+
+
+TEST_CASE("Colormap interpolates between colors", "[colormap]")
+{
+    auto colormap = wxpex::Colormap(
+        {{{0, 0, 0}}, {{255, 0, 0}}, {{255, 255, 0}}},
+        5);
+
+    REQUIRE(colormap.GetSize() == 5);
+    REQUIRE(colormap.GetTable().size() == 15);
+
+    auto first = colormap.GetColor(0);
+    auto middle = colormap.GetColor(2);
+    auto quarter = colormap.GetColor(1);
+    auto last = colormap.GetColor(4);
+
+    REQUIRE(first.red == 0);
+    REQUIRE(quarter.red == 128);
+    REQUIRE(quarter.green == 0);
+    REQUIRE(middle.red == 255);
+    REQUIRE(middle.green == 0);
+    REQUIRE(last.green == 255);
+
+    REQUIRE_THROWS_AS(wxpex::Colormap({}, 256), std::invalid_argument);
+
+    REQUIRE_THROWS_AS(
+        wxpex::Colormap({{{0, 0, 0}}}, 1),
+        std::invalid_argument);
+}
+
+
+TEST_CASE("MapColors clamps to the range", "[colormap]")
+{
+    auto gray = wxpex::Colormap::Gray(4096);
+
+    std::vector<float> values{
+        -1.0f,
+        0.0f,
+        0.5f,
+        1.0f,
+        2.0f,
+        std::numeric_limits<float>::quiet_NaN()};
+
+    auto field = wxpex::ScalarField<float>::RowMajor(
+        values.data(),
+        static_cast<int>(values.size()),
+        1);
+
+    std::vector<unsigned char> rgb(values.size() * 3);
+    wxpex::MapColors(gray, field, 0.0, 1.0, rgb.data());
+
+    REQUIRE(rgb[0] == 0);
+    REQUIRE(rgb[3] == 0);
+    REQUIRE(rgb[6] == 128);
+    REQUIRE(rgb[9] == 255);
+    REQUIRE(rgb[12] == 255);
+
+    // NaN gets the first color.
+    REQUIRE(rgb[15] == 0);
+
+    // An empty range maps everything to the first color.
+    wxpex::MapColors(gray, field, 1.0, 1.0, rgb.data());
+    REQUIRE(rgb[12] == 0);
+}
+
+
+TEST_CASE("MapColors reads Eigen storage order", "[colormap]")
+{
+    // Column-major, so rows are not contiguous.
+    Eigen::MatrixXd matrix(2, 3);
+    matrix << 0.0, 1.0, 2.0,
+              3.0, 4.0, 5.0;
+
+    auto field = wxpex::MakeScalarField(matrix);
+
+    REQUIRE(field.width == 3);
+    REQUIRE(field.height == 2);
+    REQUIRE(field.columnStride == 2);
+    REQUIRE(field.rowStride == 1);
+
+    std::vector<unsigned char> rgb(18);
+    wxpex::MapColors(wxpex::Colormap::Gray(6), field, 0.0, 5.0, rgb.data());
+
+    // Gray with 6 entries has steps of 51.
+    for (size_t i = 0; i < 6; ++i)
+    {
+        REQUIRE(rgb[i * 3] == i * 51);
+    }
+}
+
+
+TEST_CASE("Threads map the same colors", "[colormap]")
+{
+    int width = 333;
+    int height = 257;
+
+    std::vector<uint16_t> values(static_cast<size_t>(width * height));
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<uint16_t>((i * 37) % 4096);
+    }
+
+    auto field = wxpex::ScalarField<uint16_t>::RowMajor(
+        values.data(),
+        width,
+        height);
+
+    auto rainbow = wxpex::Colormap::Rainbow(4096);
+
+    std::vector<unsigned char> expected(values.size() * 3);
+
+    wxpex::MapColors(
+        rainbow,
+        field,
+        0.0,
+        4095.0,
+        expected.data(),
+        wxpex::ConversionSettings().ThreadCount(1));
+
+    auto threadCount = GENERATE(2u, 5u, 16u);
+
+    std::vector<unsigned char> rgb(values.size() * 3);
+
+    wxpex::MapColors(
+        rainbow,
+        field,
+        0.0,
+        4095.0,
+        rgb.data(),
+        wxpex::ConversionSettings()
+            .ThreadCount(threadCount)
+            .MinimumPerThread(100));
+
+    REQUIRE(rgb == expected);
+}
+
+
+TEST_CASE("Changing the range does not reallocate", "[colormap]")
+{
+    std::vector<float> values(64 * 48);
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<float>(i % 64);
+    }
+
+    wxpex::ColormapRenderer<float> renderer(wxpex::Colormap::Gray(), 0, 63);
+    renderer.SetField(
+        wxpex::ScalarField<float>::RowMajor(values.data(), 64, 48));
+
+    auto data = renderer.Render().GetData();
+
+    REQUIRE(renderer.GetImage().GetWidth() == 64);
+    REQUIRE(renderer.GetImage().GetRed(63, 0) == 255);
+
+    renderer.SetRange(0, 252);
+    renderer.Render();
+
+    REQUIRE(renderer.GetImage().GetData() == data);
+    REQUIRE(renderer.GetImage().GetRed(63, 0) == 64);
+}
+
+
+TEST_CASE("Colormap benchmarks", "[.benchmark]")
+{
+    int width = 1920;
+    int height = 1080;
+
+    std::vector<float> values(static_cast<size_t>(width * height));
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = std::sin(static_cast<float>(i) * 0.001f);
+    }
+
+    wxpex::ColormapRenderer<float> renderer(
+        wxpex::Colormap::Rainbow(4096),
+        -1.0,
+        1.0);
+
+    renderer.SetField(
+        wxpex::ScalarField<float>::RowMajor(values.data(), width, height));
+
+    renderer.Render();
+
+    BENCHMARK("Map 1920x1080 floats")
+    {
+        return renderer.Render().GetData();
+    };
+
+    BENCHMARK("Map 1920x1080 floats, one thread")
+    {
+        std::vector<unsigned char> rgb(values.size() * 3);
+
+        wxpex::MapColors(
+            wxpex::Colormap::Gray(),
+            wxpex::ScalarField<float>::RowMajor(values.data(), width, height),
+            -1.0,
+            1.0,
+            rgb.data(),
+            wxpex::ConversionSettings().ThreadCount(1));
+
+        return rgb[0];
+    };
+}
@@ -0,0 +1,111 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <wxpex/converter.h>
+#include <tau/random.h>
+
+
+template<typename T, int base, int width, int precision>
+using Chars =
+    wxpex::CharsConverter<T, wxpex::ViewTraits<base, width, precision>>;
+
+
+TEST_CASE("CharsConverter formats integers", "[converter]")
+{
+    REQUIRE(Chars<int, 10, -1, -1>::ToString(0) == "0");
+    REQUIRE(Chars<int, 10, -1, -1>::ToString(-42) == "-42");
+    REQUIRE(Chars<int, 10, 6, -1>::ToString(42) == "    42");
+    REQUIRE(Chars<int, 10, 6, 4>::ToString(-42) == " -0042");
+    REQUIRE(Chars<unsigned, 16, -1, -1>::ToString(255u) == "ff");
+    REQUIRE(Chars<uint8_t, 2, 8, 8>::ToString(uint8_t{5}) == "00000101");
+
+    REQUIRE(
+        Chars<int64_t, 10, -1, -1>::ToString(
+            std::numeric_limits<int64_t>::min())
+        == "-9223372036854775808");
+}
+
+
+TEST_CASE("CharsConverter formats floating-point values", "[converter]")
+{
+    REQUIRE(Chars<double, 10, -1, 3>::ToString(3.14159) == "3.142");
+    REQUIRE(Chars<double, 10, 8, 2>::ToString(-1.5) == "   -1.50");
+    REQUIRE(Chars<double, 10, -1, 0>::ToString(2.5) == "2");
+    REQUIRE(Chars<float, 10, -1, 1>::ToString(0.25f) == "0.2");
+
+    // Values too large for fixed notation are still formatted.
+    REQUIRE(!Chars<double, 10, -1, 3>::ToString(1e300).empty());
+}
+
+
+TEST_CASE("CharsConverter round trips", "[converter]")
+{
+    auto seed = GENERATE(
+        take(16, random(tau::SeedLimits::min(), tau::SeedLimits::max())));
+
+    tau::UniformRandom<double> uniformRandom{seed};
+    uniformRandom.SetRange(-1e6, 1e6);
+    auto value = uniformRandom();
+
+    using Shortest = Chars<double, 10, -1, -1>;
+    auto asString = Shortest::ToString(value).ToStdString();
+    REQUIRE(Shortest::ToValue(asString) == value);
+
+    using Integer = Chars<int, 10, 12, -1>;
+    auto integer = static_cast<int>(value);
+    auto integerString = Integer::ToString(integer).ToStdString();
+    REQUIRE(Integer::ToValue(integerString) == integer);
+}
+
+
+TEST_CASE("CharsConverter rejects invalid input", "[converter]")
+{
+    using Integer = Chars<int8_t, 10, -1, -1>;
+
+    REQUIRE(Integer::ToValue(" +12 ") == 12);
+    REQUIRE_THROWS_AS(Integer::ToValue("12a"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Integer::ToValue(""), std::invalid_argument);
+    REQUIRE_THROWS_AS(Integer::ToValue("1000"), std::out_of_range);
+
+    using Hex = Chars<unsigned, 16, -1, -1>;
+    REQUIRE(Hex::ToValue("0xff") == 255u);
+}
+
+
+// Hidden by default. Run with:
+//     wxpex_tests "[.benchmark]"
+TEST_CASE("Converter benchmarks", "[.benchmark]")
+{
+    using Traits = wxpex::ViewTraits<10, 10, 3>;
+    using IntTraits = wxpex::ViewTraits<10, 8, -1>;
+
+    double value = 1234.56789;
+    int integer = -1234567;
+
+    BENCHMARK("pex::Converter<double>")
+    {
+        return wxString(pex::Converter<double, Traits>::ToString(value));
+    };
+
+    BENCHMARK("CharsConverter<double>")
+    {
+        return wxpex::CharsConverter<double, Traits>::ToString(value);
+    };
+
+    BENCHMARK("pex::Converter<int>")
+    {
+        return wxString(pex::Converter<int, IntTraits>::ToString(integer));
+    };
+
+    BENCHMARK("CharsConverter<int>")
+    {
+        return wxpex::CharsConverter<int, IntTraits>::ToString(integer);
+    };
+
+    BENCHMARK("CharsConverter<int>::Format")
+    {
+        typename wxpex::CharsConverter<int, IntTraits>::Buffer buffer;
+        return wxpex::CharsConverter<int, IntTraits>::Format(buffer, integer);
+    };
+}
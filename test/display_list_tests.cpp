@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+
+#include <wxpex/display_list.h>
+
+
+TEST_CASE("DisplayNode bounds include the stroke", "[display_list]")
+{
+    wxpex::DisplayNode node;
+
+    REQUIRE(node.IsEmpty());
+    REQUIRE(!node.GetBounds());
+
+    node.SetPen(wxGraphicsPenInfo(*wxBLACK, 4.0))
+        .DrawRectangle(wxRect2DDouble(10.0, 20.0, 30.0, 40.0));
+
+    REQUIRE(!node.IsEmpty());
+    REQUIRE(node.GetBounds());
+
+    // Half the pen width, and one pixel for antialiasing.
+    auto bounds = *node.GetBounds();
+    REQUIRE(bounds.m_x == Approx(7.0));
+    REQUIRE(bounds.m_y == Approx(17.0));
+    REQUIRE(bounds.m_width == Approx(36.0));
+    REQUIRE(bounds.m_height == Approx(46.0));
+}
+
+
+TEST_CASE("DisplayNode bounds of filled shapes", "[display_list]")
+{
+    wxpex::DisplayNode node;
+
+    node.SetPen(wxGraphicsPenInfo(*wxBLACK, 10.0))
+        .DrawEllipse(
+            wxRect2DDouble(0.0, 0.0, 10.0, 10.0),
+            wxpex::DisplayNode::Mode::fill)
+        .DrawLines(
+            {{50.0, 60.0}, {70.0, 20.0}, {40.0, 30.0}},
+            true,
+            wxpex::DisplayNode::Mode::fill);
+
+    auto bounds = *node.GetBounds();
+    REQUIRE(bounds.GetLeft() == Approx(-1.0));
+    REQUIRE(bounds.GetTop() == Approx(-1.0));
+    REQUIRE(bounds.GetRight() == Approx(71.0));
+    REQUIRE(bounds.GetBottom() == Approx(61.0));
+}
+
+
+TEST_CASE("DisplayList updates a single node", "[display_list]")
+{
+    wxpex::DisplayList displayList;
+    size_t recordCount = 0;
+
+    auto first = displayList.AddNode(
+        [&](wxpex::DisplayNode &node) -> void
+        {
+            ++recordCount;
+            node.DrawRectangle(wxRect2DDouble(0.0, 0.0, 10.0, 10.0));
+        });
+
+    auto second = displayList.AddNode(
+        [&](wxpex::DisplayNode &node) -> void
+        {
+            ++recordCount;
+            node.StrokeLine({0.0, 0.0}, {5.0, 5.0});
+        });
+
+    REQUIRE(displayList.GetCount() == 2);
+    REQUIRE(recordCount == 2);
+
+    displayList.Update(
+        second,
+        [&](wxpex::DisplayNode &node) -> void
+        {
+            ++recordCount;
+            node.StrokeLine({100.0, 100.0}, {105.0, 105.0});
+        });
+
+    REQUIRE(recordCount == 3);
+    REQUIRE(displayList.GetNode(first).GetBounds()->GetLeft() < 0.0);
+    REQUIRE(displayList.GetNode(second).GetBounds()->GetLeft() > 98.0);
+
+    displayList.SetVisible(first, false);
+    REQUIRE(!displayList.IsVisible(first));
+    REQUIRE(displayList.IsVisible(second));
+
+    REQUIRE_THROWS_AS(displayList.IsVisible(2), std::out_of_range);
+}
+
+
+TEST_CASE("DisplayNode ignores empty lines", "[display_list]")
+{
+    wxpex::DisplayNode node;
+
+    node.DrawLines({}, false)
+        .DrawRectangle(
+            wxRect2DDouble(10.0, 20.0, 30.0, 40.0),
+            wxpex::DisplayNode::Mode::fill);
+
+    // The empty lines do not pull the bounds to the origin.
+    auto bounds = *node.GetBounds();
+    REQUIRE(bounds.GetLeft() == Approx(9.0));
+    REQUIRE(bounds.GetTop() == Approx(19.0));
+
+    wxpex::DisplayNode empty;
+    empty.DrawLines({}, true);
+    REQUIRE(empty.IsEmpty());
+    REQUIRE(!empty.GetBounds());
+}
+
+
+TEST_CASE("TransformBounds maps bounds to window coordinates", "[display_list]")
+{
+    auto bounds = wxRect2DDouble(10.0, 20.0, 30.0, 40.0);
+
+    SECTION("scale and translation")
+    {
+        auto transform = wxpex::GraphicsMatrix(2.0, 0.0, 0.0, 2.0, 5.0, 7.0);
+        auto mapped = wxpex::TransformBounds(transform, bounds);
+
+        REQUIRE(mapped.GetLeft() == Approx(25.0));
+        REQUIRE(mapped.GetTop() == Approx(47.0));
+        REQUIRE(mapped.GetRight() == Approx(85.0));
+        REQUIRE(mapped.GetBottom() == Approx(127.0));
+    }
+
+    SECTION("rotation by 90 degrees")
+    {
+        // (x, y) maps to (-y, x).
+        auto transform = wxpex::GraphicsMatrix(0.0, 1.0, -1.0, 0.0, 0.0, 0.0);
+        auto mapped = wxpex::TransformBounds(transform, bounds);
+
+        REQUIRE(mapped.GetLeft() == Approx(-60.0));
+        REQUIRE(mapped.GetTop() == Approx(10.0));
+        REQUIRE(mapped.GetRight() == Approx(-20.0));
+        REQUIRE(mapped.GetBottom() == Approx(40.0));
+    }
+}
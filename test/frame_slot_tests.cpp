@@ -0,0 +1,96 @@
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <wxpex/frame_slot.h>
+
+
+TEST_CASE("Reader gets the newest published frame", "[frame_slot]")
+{
+    wxpex::FrameSlot<int> slot;
+
+    REQUIRE(!slot.Acquire());
+
+    slot.GetWriteBuffer() = 1;
+    slot.Publish();
+    slot.GetWriteBuffer() = 2;
+    slot.Publish();
+
+    REQUIRE(slot.HasNewFrame());
+    REQUIRE(slot.Acquire());
+    REQUIRE(slot.GetReadBuffer() == 2);
+
+    // Nothing new has been published.
+    REQUIRE(!slot.Acquire());
+    REQUIRE(slot.GetReadBuffer() == 2);
+
+    slot.GetWriteBuffer() = 3;
+    slot.Publish();
+
+    REQUIRE(slot.Acquire());
+    REQUIRE(slot.GetReadBuffer() == 3);
+}
+
+
+TEST_CASE("ImageFrame keeps its storage", "[frame_slot]")
+{
+    wxpex::ImageFrame frame;
+    REQUIRE(frame.IsEmpty());
+
+    frame.Resize(64, 32);
+    REQUIRE(frame.rgb.size() == 64 * 32 * 3);
+
+    auto data = frame.rgb.data();
+    frame.Resize(32, 32);
+    frame.Resize(64, 32);
+
+    REQUIRE(frame.rgb.data() == data);
+}
+
+
+TEST_CASE("Frames are never torn", "[frame_slot]")
+{
+    static constexpr size_t frameCount = 20000;
+    static constexpr size_t frameSize = 256;
+
+    wxpex::FrameSlot<std::vector<size_t>> slot;
+
+    std::thread writer(
+        [&slot]()
+        {
+            for (size_t i = 1; i <= frameCount; ++i)
+            {
+                auto &buffer = slot.GetWriteBuffer();
+                buffer.assign(frameSize, i);
+                slot.Publish();
+            }
+        });
+
+    size_t previous = 0;
+    bool isTorn = false;
+    bool isOutOfOrder = false;
+
+    while (previous < frameCount)
+    {
+        if (!slot.Acquire())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        auto &frame = slot.GetReadBuffer();
+        auto first = frame.front();
+
+        for (auto value: frame)
+        {
+            isTorn |= (value != first);
+        }
+
+        isOutOfOrder |= (first <= previous);
+        previous = first;
+    }
+
+    writer.join();
+
+    REQUIRE(!isTorn);
+    REQUIRE(!isOutOfOrder);
+}
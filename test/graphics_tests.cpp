@@ -131,3 +131,110 @@ TEST_CASE("Extract translation/rotation/scale", "[graphics]")
     std::cout << "rotation: " << rotation << std::endl;
     std::cout << graphicsMatrix << std::endl;
 }
+
+
+TEST_CASE("TransformPoints matches wxGraphicsMatrix", "[graphics]")
+{
+    auto renderer = wxGraphicsRenderer::GetDefaultRenderer();
+    auto matrix = renderer->CreateMatrix();
+
+    matrix.Translate(12.0, -40.0);
+    matrix.Scale(2.5, 0.75);
+    matrix.Rotate(tau::ToRadians(30.0));
+
+    auto graphicsMatrix = wxpex::GraphicsMatrix(matrix);
+
+    std::vector<tau::Point2d<double>> points;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        points.emplace_back(i * 3.0 - 150.0, 80.0 - i * 1.5);
+    }
+
+    auto original = points;
+    graphicsMatrix.TransformPoints(points);
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        double x = original[i].x;
+        double y = original[i].y;
+        matrix.TransformPoint(&x, &y);
+
+        REQUIRE(points[i].x == Approx(x));
+        REQUIRE(points[i].y == Approx(y));
+    }
+
+    graphicsMatrix.InverseTransformPoints(points);
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        REQUIRE(points[i].x == Approx(original[i].x).margin(1e-9));
+        REQUIRE(points[i].y == Approx(original[i].y).margin(1e-9));
+    }
+}
+
+
+TEST_CASE("Decomposition follows the coefficients", "[graphics]")
+{
+    auto renderer = wxGraphicsRenderer::GetDefaultRenderer();
+    auto matrix = renderer->CreateMatrix();
+
+    auto graphicsMatrix = wxpex::GraphicsMatrix(matrix);
+
+    REQUIRE(graphicsMatrix.GetRotation() == 0.0);
+    REQUIRE(graphicsMatrix.IsInvertible());
+
+    matrix.Rotate(tau::ToRadians(45.0));
+    matrix.Get(
+        &graphicsMatrix.a,
+        &graphicsMatrix.b,
+        &graphicsMatrix.c,
+        &graphicsMatrix.d,
+        &graphicsMatrix.tx,
+        &graphicsMatrix.ty);
+
+    REQUIRE(graphicsMatrix.GetRotation() == Approx(tau::ToRadians(45.0)));
+
+    graphicsMatrix.a = 0.0;
+    graphicsMatrix.b = 0.0;
+
+    REQUIRE(!graphicsMatrix.IsInvertible());
+
+    REQUIRE_THROWS_AS(
+        graphicsMatrix.InverseTransformPoint(tau::Point2d<double>(1.0, 1.0)),
+        wxpex::GraphicsError);
+}
+
+
+TEST_CASE("Transform points", "[.benchmark]")
+{
+    auto renderer = wxGraphicsRenderer::GetDefaultRenderer();
+    auto matrix = renderer->CreateMatrix();
+    matrix.Scale(2.0, 3.0);
+    matrix.Rotate(0.3);
+
+    auto graphicsMatrix = wxpex::GraphicsMatrix(matrix);
+    auto source = std::vector<tau::Point2d<double>>(
+        100000,
+        tau::Point2d<double>(1.0, 2.0));
+
+    BENCHMARK("wxGraphicsMatrix::TransformPoint")
+    {
+        auto points = source;
+
+        for (auto &point: points)
+        {
+            matrix.TransformPoint(&point.x, &point.y);
+        }
+
+        return points;
+    };
+
+    BENCHMARK("GraphicsMatrix::TransformPoints")
+    {
+        auto points = source;
+        graphicsMatrix.TransformPoints(points);
+
+        return points;
+    };
+}
@@ -0,0 +1,191 @@
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <wxpex/histogram.h>
+
+
+static std::vector<float> MakeSamples(size_t count, unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> result(count);
+
+    for (auto &sample: result)
+    {
+        sample = distribution(generator);
+    }
+
+    return result;
+}
+
+
+// Counts the last windowSize samples from scratch.
+static wxpex::HistogramBins CountDirectly(
+    const std::vector<float> &samples,
+    size_t windowSize,
+    double low,
+    double high,
+    size_t binCount)
+{
+    auto settings = wxpex::HistogramSettings()
+        .Range(low, high)
+        .BinCount(binCount)
+        .WindowSize(windowSize);
+
+    wxpex::HistogramCounts counts(settings);
+
+    auto first = samples.size() - std::min(samples.size(), windowSize);
+
+    for (auto index = first; index < samples.size(); ++index)
+    {
+        counts.Append(&samples[index], 1);
+    }
+
+    return counts.GetBins();
+}
+
+
+TEST_CASE("HistogramCounts bins samples", "[histogram]")
+{
+    auto settings = wxpex::HistogramSettings()
+        .Range(0.0, 4.0)
+        .BinCount(4)
+        .WindowSize(100);
+
+    wxpex::HistogramCounts counts(settings);
+
+    counts.Append(
+        {
+            -1.0f,
+            0.0f,
+            0.5f,
+            1.0f,
+            3.99f,
+            4.0f,
+            std::numeric_limits<float>::quiet_NaN()});
+
+    auto bins = counts.GetBins();
+
+    REQUIRE(bins.counts == std::vector<uint32_t>{2, 1, 0, 1});
+    REQUIRE(bins.underflow == 1);
+    REQUIRE(bins.overflow == 1);
+    REQUIRE(bins.ignored == 1);
+    REQUIRE(bins.GetMaximum() == 2);
+
+    REQUIRE_THROWS_AS(counts.SetRange(1.0, 1.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(counts.SetBinCount(0), std::invalid_argument);
+}
+
+
+TEST_CASE("HistogramCounts slides its window", "[histogram]")
+{
+    size_t windowSize = 1000;
+
+    auto settings = wxpex::HistogramSettings()
+        .Range(-2.0, 2.0)
+        .BinCount(32)
+        .WindowSize(windowSize);
+
+    wxpex::HistogramCounts counts(settings);
+    std::vector<float> appended;
+    std::mt19937 generator(5);
+
+    for (unsigned batch = 0; batch < 40; ++batch)
+    {
+        // Some batches are larger than the window.
+        auto samples = MakeSamples(generator() % 1200, batch);
+        counts.Append(samples);
+        appended.insert(appended.end(), samples.begin(), samples.end());
+
+        auto bins = counts.GetBins();
+        auto expected = CountDirectly(appended, windowSize, -2.0, 2.0, 32);
+
+        REQUIRE(counts.GetCount() == std::min(windowSize, appended.size()));
+        REQUIRE(bins.counts == expected.counts);
+        REQUIRE(bins.underflow == expected.underflow);
+        REQUIRE(bins.overflow == expected.overflow);
+    }
+}
+
+
+TEST_CASE("HistogramCounts rebins lazily", "[histogram]")
+{
+    auto settings = wxpex::HistogramSettings()
+        .Range(-1.0, 1.0)
+        .BinCount(10)
+        .WindowSize(500);
+
+    wxpex::HistogramCounts counts(settings);
+    std::vector<float> appended;
+
+    auto first = MakeSamples(300, 1);
+    counts.Append(first);
+    appended.insert(appended.end(), first.begin(), first.end());
+    counts.GetBins();
+    REQUIRE(!counts.IsStale());
+
+    // The same range is not a change.
+    counts.SetRange(-1.0, 1.0);
+    REQUIRE(!counts.IsStale());
+
+    counts.SetRange(-3.0, 3.0);
+    counts.SetBinCount(24);
+    REQUIRE(counts.IsStale());
+
+    // Batches while stale are only stored.
+    auto second = MakeSamples(400, 2);
+    counts.Append(second);
+    appended.insert(appended.end(), second.begin(), second.end());
+    REQUIRE(counts.IsStale());
+
+    auto bins = counts.GetBins();
+    REQUIRE(!counts.IsStale());
+    REQUIRE(bins.low == -3.0);
+    REQUIRE(bins.counts.size() == 24);
+    REQUIRE(bins.counts == CountDirectly(appended, 500, -3.0, 3.0, 24).counts);
+}
+
+
+TEST_CASE("Bin sequences never repeat", "[histogram]")
+{
+    // A default HistogramBins, as held before anything is published, has
+    // sequence 0.
+    auto first = wxpex::HistogramBins::GetNextSequence();
+    auto second = wxpex::HistogramBins::GetNextSequence();
+
+    REQUIRE(first > wxpex::HistogramBins{}.sequence);
+    REQUIRE(second > first);
+}
+
+
+TEST_CASE("HistogramCounts benchmarks", "[.benchmark]")
+{
+    auto settings = wxpex::HistogramSettings()
+        .Range(-4.0, 4.0)
+        .BinCount(256)
+        .WindowSize(1'000'000);
+
+    wxpex::HistogramCounts counts(settings);
+    auto batch = MakeSamples(10'000, 1);
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        counts.Append(batch);
+    }
+
+    BENCHMARK("Append 10000 samples to a full window")
+    {
+        counts.Append(batch);
+
+        return counts.GetBins().counts.front();
+    };
+
+    BENCHMARK("Rebin 1000000 samples")
+    {
+        counts.SetBinCount((counts.GetBins().counts.size() == 256) ? 128 : 256);
+
+        return counts.GetBins().counts.front();
+    };
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+
+#include <wxpex/layered_canvas.h>
+
+#include "render_harness.h"
+
+
+TEST_CASE("Stale rects are combined", "[layered_canvas]")
+{
+    std::optional<wxRect> stale;
+
+    wxpex::AddStaleRect(stale, wxRect(10, 20, 5, 5));
+    REQUIRE(stale == wxRect(10, 20, 5, 5));
+
+    wxpex::AddStaleRect(stale, wxRect(40, 0, 10, 10));
+    REQUIRE(stale == wxRect(10, 0, 40, 25));
+
+    // A rect within the stale area changes nothing.
+    wxpex::AddStaleRect(stale, wxRect(12, 2, 2, 2));
+    REQUIRE(stale == wxRect(10, 0, 40, 25));
+}
+
+
+TEST_CASE("Layer tiles only draw their stale area", "[layered_canvas]")
+{
+    // The tile at (32, 0) of a layer, with part of it stale.
+    auto tile = wxRect(32, 0, 32, 32);
+    auto area = wxRect(40, 8, 8, 8);
+
+    std::optional<wxRect> drawnArea;
+
+    auto drawLayer = [&](wxpex::GraphicsContext &context, const wxRect &stale)
+    {
+        drawnArea = stale;
+
+        // Covers the whole layer, but only the stale area is drawn, and
+        // only its right half is filled.
+        context->SetPen(wxNullPen);
+        context->SetBrush(wxBrush(*wxBLUE));
+        context->DrawRectangle(44.0, 0.0, 100.0, 100.0);
+    };
+
+    auto rendering = render::Render(
+        {tile.width, tile.height},
+        [&](wxpex::GraphicsContext &context)
+        {
+            // The tile before the update, opaque red everywhere.
+            context->SetPen(wxNullPen);
+            context->SetBrush(wxBrush(*wxRED));
+            context->DrawRectangle(0.0, 0.0, 32.0, 32.0);
+
+            wxpex::DrawLayerTile(context, tile, area, drawLayer);
+        });
+
+    REQUIRE(drawnArea == area);
+
+    auto &image = rendering.image;
+
+    // Outside of the stale area, the tile is unchanged.
+    REQUIRE(image.GetAlpha(2, 2) == 255);
+    REQUIRE(image.GetRed(2, 2) == 255);
+    REQUIRE(image.GetRed(20, 20) == 255);
+    REQUIRE(image.GetBlue(20, 20) == 0);
+
+    // The left half of the stale area was cleared.
+    REQUIRE(image.GetAlpha(9, 12) == 0);
+
+    // The right half was drawn.
+    REQUIRE(image.GetAlpha(13, 12) == 255);
+    REQUIRE(image.GetBlue(13, 12) == 255);
+    REQUIRE(image.GetRed(13, 12) == 0);
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <wxpex/offscreen.h>
+
+
+TEST_CASE("Tiles cover the canvas exactly once", "[offscreen]")
+{
+    auto size = tau::Size<int>(100, 70);
+    auto tiles = wxpex::MakeTiles(size, 32);
+
+    // 4 columns and 3 rows, with partial tiles on the right and bottom.
+    REQUIRE(tiles.size() == 12);
+    REQUIRE(tiles.back() == wxRect(96, 64, 4, 6));
+
+    std::vector<int> coverage(100 * 70, 0);
+
+    for (auto &tile: tiles)
+    {
+        for (int y = tile.GetTop(); y <= tile.GetBottom(); ++y)
+        {
+            for (int x = tile.GetLeft(); x <= tile.GetRight(); ++x)
+            {
+                ++coverage.at(static_cast<size_t>(y * 100 + x));
+            }
+        }
+    }
+
+    for (auto count: coverage)
+    {
+        REQUIRE(count == 1);
+    }
+
+    REQUIRE_THROWS_AS(wxpex::MakeTiles(size, 0), std::invalid_argument);
+}
+
+
+TEST_CASE("Tiled rendering matches a single tile", "[offscreen]")
+{
+    auto size = tau::Size<int>(90, 60);
+
+    // Each worker creates its own brush, as stock objects are shared.
+    auto drawTile = [](wxpex::GraphicsContext &context, const wxRect &)
+    {
+        context->SetPen(wxGraphicsPen());
+        context->SetBrush(context->CreateBrush(wxBrush(wxColour(255, 0, 0))));
+        context->DrawEllipse(5.5, 7.25, 70.0, 45.0);
+    };
+
+    auto whole = wxpex::RenderOffscreen(
+        size,
+        drawTile,
+        wxpex::OffscreenSettings().TileSize(1000).ThreadCount(1));
+
+    auto tiled = wxpex::RenderOffscreen(
+        size,
+        drawTile,
+        wxpex::OffscreenSettings().TileSize(16).ThreadCount(4));
+
+    auto pixelCount = static_cast<size_t>(size.width * size.height);
+
+    REQUIRE(
+        std::memcmp(whole.GetData(), tiled.GetData(), pixelCount * 3) == 0);
+
+    REQUIRE(
+        std::memcmp(whole.GetAlpha(), tiled.GetAlpha(), pixelCount) == 0);
+
+    // Inside and outside of the ellipse.
+    REQUIRE(tiled.GetAlpha(40, 30) == 255);
+    REQUIRE(tiled.GetRed(40, 30) == 255);
+    REQUIRE(tiled.GetAlpha(1, 1) == 0);
+}
@@ -0,0 +1,73 @@
+#include <catch2/catch.hpp>
+
+#include <wxpex/paint_profiler.h>
+
+
+using Duration = wxpex::PaintHistogram::Duration;
+
+
+TEST_CASE("Paint histogram buckets", "[paint_profiler]")
+{
+    REQUIRE(wxpex::PaintHistogram::GetBucket(Duration(0.05)) == 0);
+    REQUIRE(wxpex::PaintHistogram::GetBucket(Duration(0.1)) == 0);
+    REQUIRE(wxpex::PaintHistogram::GetBucket(Duration(0.3)) == 2);
+    REQUIRE(wxpex::PaintHistogram::GetBucket(Duration(20.0)) == 8);
+
+    REQUIRE(
+        wxpex::PaintHistogram::GetBucket(Duration(500.0))
+            == wxpex::PaintHistogram::bucketCount - 1);
+}
+
+
+TEST_CASE("Paint histogram keeps a rolling window", "[paint_profiler]")
+{
+    wxpex::PaintHistogram histogram(4);
+
+    REQUIRE(!histogram.GetLast());
+
+    for (auto duration: {1.0, 2.0, 3.0, 4.0})
+    {
+        histogram.Add(Duration(duration));
+    }
+
+    REQUIRE(histogram.GetCount() == 4);
+    REQUIRE(histogram.GetMean().count() == Approx(2.5));
+    REQUIRE(histogram.GetMaximum().count() == Approx(4.0));
+    REQUIRE(histogram.GetPercentile(0.5).count() == Approx(2.0));
+
+    // 1.0 and 2.0 leave the window.
+    histogram.Add(Duration(10.0));
+    histogram.Add(Duration(0.05));
+
+    REQUIRE(histogram.GetCount() == 4);
+    REQUIRE(histogram.GetTotalCount() == 6);
+    REQUIRE(histogram.GetLast()->count() == Approx(0.05));
+    REQUIRE(histogram.GetMaximum().count() == Approx(10.0));
+    REQUIRE(histogram.GetPercentile(1.0).count() == Approx(10.0));
+    REQUIRE(histogram.GetPercentile(0.0).count() == Approx(0.05));
+
+    size_t bucketTotal = 0;
+
+    for (auto count: histogram.GetBuckets())
+    {
+        bucketTotal += count;
+    }
+
+    REQUIRE(bucketTotal == 4);
+
+    // The 1.0 ms paint left, and the 0.05 ms paint entered.
+    REQUIRE(histogram.GetBuckets()[3] == 0);
+    REQUIRE(histogram.GetBuckets()[0] == 1);
+}
+
+
+TEST_CASE("Disabled profiler records nothing", "[paint_profiler]")
+{
+    REQUIRE(!wxpex::PaintProfiler::IsEnabled());
+
+    {
+        wxpex::ScopedPaintTimer timer(nullptr);
+    }
+
+    REQUIRE(!wxpex::PaintProfiler::GetHistogram(nullptr));
+}
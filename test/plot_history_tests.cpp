@@ -0,0 +1,188 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <wxpex/plot_history.h>
+
+
+static std::vector<float> MakeSamples(size_t count, unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> result(count);
+
+    for (auto &sample: result)
+    {
+        sample = distribution(generator);
+    }
+
+    return result;
+}
+
+
+static wxpex::Envelope GetExpected(
+    const std::vector<float> &samples,
+    uint64_t first,
+    uint64_t last)
+{
+    wxpex::Envelope result;
+
+    for (auto index = first; index < last; ++index)
+    {
+        result.Add(samples[static_cast<size_t>(index)]);
+    }
+
+    return result;
+}
+
+
+TEST_CASE("PlotHistory envelopes match the samples", "[plot_history]")
+{
+    auto capacity = GENERATE(size_t(1), size_t(7), size_t(64), size_t(1000));
+
+    wxpex::PlotHistory history(capacity);
+    std::vector<float> appended;
+    std::mt19937 generator(7);
+
+    for (unsigned batch = 0; batch < 50; ++batch)
+    {
+        // Batches smaller and larger than the capacity.
+        auto samples = MakeSamples(generator() % (2 * capacity + 3), batch);
+        history.Append(samples);
+        appended.insert(appended.end(), samples.begin(), samples.end());
+
+        REQUIRE(history.GetEnd() == appended.size());
+        REQUIRE(history.GetCount() == std::min(capacity, appended.size()));
+
+        for (unsigned query = 0; query < 20; ++query)
+        {
+            auto first = generator() % (appended.size() + 1);
+            auto last = generator() % (appended.size() + 1);
+
+            if (first > last)
+            {
+                std::swap(first, last);
+            }
+
+            auto envelope = history.GetEnvelope(first, last);
+
+            // Samples that have left the history are not included.
+            auto expected = GetExpected(
+                appended,
+                std::max<uint64_t>(first, history.GetBegin()),
+                last);
+
+            REQUIRE(envelope.IsEmpty() == expected.IsEmpty());
+
+            if (!expected.IsEmpty())
+            {
+                REQUIRE(envelope.minimum == expected.minimum);
+                REQUIRE(envelope.maximum == expected.maximum);
+            }
+        }
+    }
+}
+
+
+TEST_CASE("PlotHistory keeps the newest samples", "[plot_history]")
+{
+    wxpex::PlotHistory history(10);
+    history.Append({1, 2, 3, 4, 5, 6, 7, 8});
+    history.Append({9, 10, 11, 12});
+
+    REQUIRE(history.GetBegin() == 2);
+    REQUIRE(history.GetEnd() == 12);
+    REQUIRE(history.Get(2) == 3.0f);
+    REQUIRE(history.Get(11) == 12.0f);
+
+    auto envelope = history.GetEnvelope(0, 12);
+    REQUIRE(envelope.minimum == 3.0f);
+    REQUIRE(envelope.maximum == 12.0f);
+
+    history.Clear();
+    REQUIRE(history.IsEmpty());
+    REQUIRE(history.GetEnvelope(0, 12).IsEmpty());
+
+    REQUIRE_THROWS_AS(wxpex::PlotHistory(0), std::invalid_argument);
+}
+
+
+TEST_CASE("PlotHistory ignores empty batches", "[plot_history]")
+{
+    wxpex::PlotHistory history(100);
+    history.Append(nullptr, 0);
+    history.Append(std::vector<float>{});
+
+    REQUIRE(history.IsEmpty());
+    REQUIRE(history.GetEnd() == 0);
+
+    history.Append({1, 2, 3});
+    history.Append(std::vector<float>{});
+    REQUIRE(history.GetCount() == 3);
+    REQUIRE(history.GetEnvelope(0, 3).maximum == 3.0f);
+
+    history.Clear();
+    history.Append(std::vector<float>{});
+    REQUIRE(history.IsEmpty());
+
+    history.Append({4, 5});
+    REQUIRE(history.GetCount() == 2);
+    REQUIRE(history.GetEnvelope(0, 2).minimum == 4.0f);
+}
+
+
+TEST_CASE("PlotHistory fills columns", "[plot_history]")
+{
+    wxpex::PlotHistory history(1000);
+    auto samples = MakeSamples(1000, 3);
+    history.Append(samples);
+
+    std::vector<wxpex::Envelope> columns(30);
+    history.GetColumns(-100.0, 40.0, columns);
+
+    // Columns before the first sample are empty.
+    REQUIRE(columns[1].IsEmpty());
+
+    for (size_t column = 3; column < 27; ++column)
+    {
+        auto first = static_cast<uint64_t>(column * 40 - 100);
+        auto expected = GetExpected(samples, first, first + 40);
+
+        REQUIRE(columns[column].minimum == expected.minimum);
+        REQUIRE(columns[column].maximum == expected.maximum);
+    }
+
+    // Columns after the last sample are empty.
+    REQUIRE(columns[28].IsEmpty());
+}
+
+
+TEST_CASE("PlotHistory benchmarks", "[.benchmark]")
+{
+    size_t capacity = 10'000'000;
+    wxpex::PlotHistory history(capacity);
+    auto batch = MakeSamples(100'000, 1);
+
+    for (size_t i = 0; i < capacity / batch.size(); ++i)
+    {
+        history.Append(batch);
+    }
+
+    std::vector<wxpex::Envelope> columns(2000);
+
+    BENCHMARK("Append 100000 samples")
+    {
+        history.Append(batch);
+
+        return history.GetEnd();
+    };
+
+    BENCHMARK("2000 columns of 10 million samples")
+    {
+        history.GetColumns(
+            static_cast<double>(history.GetBegin()),
+            static_cast<double>(capacity) / 2000.0,
+            columns);
+
+        return columns.back().maximum;
+    };
+}
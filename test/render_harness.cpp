@@ -0,0 +1,175 @@
+#include "render_harness.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+
+#include <wxpex/ignores.h>
+
+WXSHIM_PUSH_IGNORES
+#include <wx/imagpng.h>
+WXSHIM_POP_IGNORES
+
+
+#ifndef WXPEX_GOLDEN_DIRECTORY
+#define WXPEX_GOLDEN_DIRECTORY "golden"
+#endif
+
+
+namespace render
+{
+
+
+namespace
+{
+
+
+void AddPngHandler()
+{
+    if (!wxImage::FindHandler(wxBITMAP_TYPE_PNG))
+    {
+        wxImage::AddHandler(new wxPNGHandler);
+    }
+}
+
+
+std::string GetGoldenDirectory()
+{
+    // The environment overrides the directory chosen by CMake.
+    auto directory = std::getenv("WXPEX_GOLDEN_DIRECTORY");
+
+    if (directory)
+    {
+        return directory;
+    }
+
+    return WXPEX_GOLDEN_DIRECTORY;
+}
+
+
+} // end anonymous namespace
+
+
+Rendering Render(const tau::Size<int> &size, const Draw &draw)
+{
+    auto drawTile = [&draw](wxpex::GraphicsContext &context, const wxRect &)
+    {
+        draw(context);
+    };
+
+    // One tile on one thread, so the time is the cost of drawing alone.
+    auto settings = wxpex::OffscreenSettings()
+        .TileSize(std::max(size.width, size.height))
+        .ThreadCount(1);
+
+    auto start = std::chrono::steady_clock::now();
+    auto image = wxpex::RenderOffscreen(size, drawTile, settings);
+    Duration renderTime = std::chrono::steady_clock::now() - start;
+
+    return {image, renderTime};
+}
+
+
+ImageDifference CompareImages(
+    const wxImage &first,
+    const wxImage &second,
+    int tolerance)
+{
+    if (first.GetSize() != second.GetSize())
+    {
+        throw std::invalid_argument("Images differ in size");
+    }
+
+    auto pixelCount =
+        static_cast<size_t>(first.GetWidth() * first.GetHeight());
+
+    auto firstData = first.GetData();
+    auto secondData = second.GetData();
+    auto firstAlpha = first.HasAlpha() ? first.GetAlpha() : nullptr;
+    auto secondAlpha = second.HasAlpha() ? second.GetAlpha() : nullptr;
+
+    ImageDifference result{0, 0};
+
+    for (size_t pixel = 0; pixel < pixelCount; ++pixel)
+    {
+        int difference = 0;
+
+        for (size_t channel = 0; channel < 3; ++channel)
+        {
+            auto index = pixel * 3 + channel;
+
+            difference = std::max(
+                difference,
+                std::abs(int(firstData[index]) - int(secondData[index])));
+        }
+
+        // A missing alpha channel is opaque.
+        int alpha = firstAlpha ? firstAlpha[pixel] : 255;
+        int otherAlpha = secondAlpha ? secondAlpha[pixel] : 255;
+        difference = std::max(difference, std::abs(alpha - otherAlpha));
+
+        result.maximumDifference =
+            std::max(result.maximumDifference, difference);
+
+        if (difference > tolerance)
+        {
+            ++result.differentPixels;
+        }
+    }
+
+    return result;
+}
+
+
+bool IsUpdatingGoldens()
+{
+    return std::getenv("WXPEX_UPDATE_GOLDEN") != nullptr;
+}
+
+
+std::string GetGoldenPath(const std::string &name)
+{
+    return (std::filesystem::path(GetGoldenDirectory()) / (name + ".png"))
+        .string();
+}
+
+
+std::optional<wxImage> LoadGolden(const std::string &name)
+{
+    auto path = GetGoldenPath(name);
+
+    if (!std::filesystem::exists(path))
+    {
+        return {};
+    }
+
+    AddPngHandler();
+
+    wxImage result;
+
+    if (!result.LoadFile(path, wxBITMAP_TYPE_PNG))
+    {
+        throw std::runtime_error("Unable to load " + path);
+    }
+
+    return result;
+}
+
+
+void SaveGolden(const std::string &name, const wxImage &image)
+{
+    auto path = GetGoldenPath(name);
+    auto directory = std::filesystem::path(path).parent_path();
+    std::filesystem::create_directories(directory);
+
+    AddPngHandler();
+
+    if (!image.SaveFile(path, wxBITMAP_TYPE_PNG))
+    {
+        throw std::runtime_error("Unable to save " + path);
+    }
+}
+
+
+} // end namespace render
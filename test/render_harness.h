@@ -0,0 +1,74 @@
+#pragma once
+
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <tau/size.h>
+
+#include <wxpex/offscreen.h>
+
+
+/**
+ ** Renders drawing code into a wxImage without a window, and compares the
+ ** result with golden images stored in test/golden.
+ **
+ ** A missing golden image fails the test. Set the environment variable
+ ** WXPEX_UPDATE_GOLDEN to write all of them from the current renderings,
+ ** after adding a scenario or after an intended change in appearance.
+ **/
+namespace render
+{
+
+
+using Draw = std::function<void(wxpex::GraphicsContext &)>;
+using Duration = std::chrono::duration<double, std::milli>;
+
+
+struct Rendering
+{
+    wxImage image;
+    Duration renderTime;
+};
+
+
+/**
+ ** Renders on the calling thread, into a transparent image.
+ **
+ ** Unlike the workers of wxpex::RenderOffscreen, draw may use wxBitmap and
+ ** the shared GraphicsResourceCache when called from the wx thread.
+ **/
+Rendering Render(const tau::Size<int> &size, const Draw &draw);
+
+
+struct ImageDifference
+{
+    // Pixels with any channel differing by more than the tolerance.
+    size_t differentPixels;
+
+    // The largest difference of any channel of any pixel.
+    int maximumDifference;
+};
+
+
+// Compares RGB and alpha. Throws std::invalid_argument if sizes differ.
+ImageDifference CompareImages(
+    const wxImage &first,
+    const wxImage &second,
+    int tolerance);
+
+
+bool IsUpdatingGoldens();
+
+
+std::string GetGoldenPath(const std::string &name);
+
+
+std::optional<wxImage> LoadGolden(const std::string &name);
+
+
+void SaveGolden(const std::string &name, const wxImage &image);
+
+
+} // end namespace render
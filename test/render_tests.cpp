@@ -0,0 +1,217 @@
+#include <catch2/catch.hpp>
+
+#include <vector>
+#include <wxpex/color.h>
+#include <wxpex/knob.h>
+#include <wxpex/polygon_batch.h>
+
+#include <wxpex/ignores.h>
+
+WXSHIM_PUSH_IGNORES
+#include <wx/init.h>
+WXSHIM_POP_IGNORES
+
+#include "render_harness.h"
+
+
+namespace
+{
+
+
+struct Scenario
+{
+    std::string name;
+    tau::Size<int> size;
+    render::Draw draw;
+};
+
+
+// Paints the way Knob does, through the cached KnobBody bitmap and the shared
+// GraphicsResourceCache. render::Render draws on the calling thread, so both
+// may be used once wx has been initialized.
+render::Draw MakeKnob(const wxpex::KnobSettings &settings, double angle)
+{
+    return [settings, angle](wxpex::GraphicsContext &context)
+    {
+        auto body = wxpex::KnobBody::Acquire(
+            {settings.radius, settings.color, 1.0});
+
+        auto side = static_cast<double>(body->GetSide());
+
+        wxpex::DrawKnob(
+            context,
+            *body,
+            tau::Point2d<double>(side / 2.0, side / 2.0),
+            static_cast<double>(settings.radius),
+            settings.GetOutlineColor(),
+            angle);
+    };
+}
+
+
+// ColorPreview has no paint handler. It shows its color by erasing its
+// background, which fills the window with the converted color.
+render::Draw MakeColorPreview(const tau::Hsv<double> &color)
+{
+    return [color](wxpex::GraphicsContext &context)
+    {
+        auto size = context.GetSize();
+
+        context->SetPen(wxNullPen);
+        context->SetBrush(wxBrush(wxpex::ToWxColour(color)));
+        context->DrawRectangle(0.0, 0.0, size.width, size.height);
+    };
+}
+
+
+render::Draw MakePolygons()
+{
+    return [](wxpex::GraphicsContext &context)
+    {
+        polygon::PolygonBatch batch;
+
+        auto red = polygon::Style{
+            {{220, 40, 40, 255}},
+            wxpex::Composition::over};
+
+        auto blue = polygon::Style{
+            {{40, 40, 220, 128}},
+            wxpex::Composition::over};
+
+        for (size_t i = 0; i < 12; ++i)
+        {
+            polygon::Recipe recipe;
+            recipe.sideCount = 3 + i;
+            recipe.sideLength = 60.0 / static_cast<double>(3 + i);
+            recipe.rotation_deg = 15.0 * static_cast<double>(i);
+
+            recipe.position = polygon::Point(
+                20.0 + 40.0 * static_cast<double>(i % 4),
+                20.0 + 40.0 * static_cast<double>(i / 4));
+
+            batch.Add(recipe, (i % 2) ? blue : red);
+        }
+
+        batch.Draw(context, polygon::Bounds{0.0, 0.0, 160.0, 120.0});
+    };
+}
+
+
+std::vector<Scenario> GetScenarios()
+{
+    auto knob = wxpex::KnobSettings().Radius(20);
+
+    auto coloredKnob = wxpex::KnobSettings()
+        .Radius(32)
+        .Color({{40, 120, 200}});
+
+    return {
+        {"knob_start", {42, 42}, MakeKnob(knob, -240.0)},
+        {"knob_middle", {42, 42}, MakeKnob(knob, -90.0)},
+        {"knob_colored", {66, 66}, MakeKnob(coloredKnob, 30.0)},
+        {"color_preview", {65, 65}, MakeColorPreview({{200.0, 0.6, 0.9}})},
+        {"color_preview_gray", {65, 65}, MakeColorPreview({{0.0, 0.0, 0.5}})},
+        {"polygons", {160, 120}, MakePolygons()}};
+}
+
+
+// Antialiasing may differ slightly between versions of a renderer.
+constexpr int channelTolerance = 2;
+constexpr double allowedFraction = 0.005;
+
+
+} // end anonymous namespace
+
+
+// Hidden until the golden images are committed to test/golden. Knobs draw
+// wxBitmaps, so this needs a display. Write the goldens with:
+//     WXPEX_UPDATE_GOLDEN=1 wxpex_tests "[.render]"
+TEST_CASE("Renderings match golden images", "[.render]")
+{
+    wxInitializer initializer;
+    REQUIRE(initializer.IsOk());
+
+    for (auto &scenario: GetScenarios())
+    {
+        DYNAMIC_SECTION(scenario.name)
+        {
+            auto rendering = render::Render(scenario.size, scenario.draw);
+
+            INFO(
+                scenario.name << " rendered in "
+                    << rendering.renderTime.count() << " ms");
+
+            if (render::IsUpdatingGoldens())
+            {
+                render::SaveGolden(scenario.name, rendering.image);
+
+                WARN(
+                    "Wrote golden image "
+                        << render::GetGoldenPath(scenario.name));
+
+                continue;
+            }
+
+            auto golden = render::LoadGolden(scenario.name);
+
+            if (!golden)
+            {
+                FAIL(
+                    "Missing golden image "
+                        << render::GetGoldenPath(scenario.name)
+                        << ". Set WXPEX_UPDATE_GOLDEN to write it.");
+            }
+
+            auto difference = render::CompareImages(
+                *golden,
+                rendering.image,
+                channelTolerance);
+
+            auto pixelCount = static_cast<size_t>(
+                scenario.size.width * scenario.size.height);
+
+            INFO("maximum difference: " << difference.maximumDifference);
+
+            REQUIRE(
+                static_cast<double>(difference.differentPixels)
+                    <= allowedFraction * static_cast<double>(pixelCount));
+        }
+    }
+}
+
+
+TEST_CASE("Image comparison", "[render]")
+{
+    auto first = wxpex::MakeTransparentImage({4, 4});
+    auto second = first.Copy();
+
+    auto same = render::CompareImages(first, second, 0);
+    REQUIRE(same.differentPixels == 0);
+    REQUIRE(same.maximumDifference == 0);
+
+    second.SetRGB(1, 1, 3, 0, 0);
+    second.SetAlpha(2, 2, 10);
+
+    auto different = render::CompareImages(first, second, 2);
+    REQUIRE(different.differentPixels == 2);
+    REQUIRE(different.maximumDifference == 10);
+
+    REQUIRE_THROWS_AS(
+        render::CompareImages(first, wxpex::MakeTransparentImage({4, 5}), 0),
+        std::invalid_argument);
+}
+
+
+TEST_CASE("Render times", "[.benchmark]")
+{
+    wxInitializer initializer;
+    REQUIRE(initializer.IsOk());
+
+    for (auto &scenario: GetScenarios())
+    {
+        BENCHMARK(scenario.name.c_str())
+        {
+            return render::Render(scenario.size, scenario.draw).image;
+        };
+    }
+}
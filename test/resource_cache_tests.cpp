@@ -0,0 +1,90 @@
+#include <catch2/catch.hpp>
+
+#include <wxpex/resource_cache.h>
+
+
+TEST_CASE("LruCache evicts the least recently used value", "[resource_cache]")
+{
+    wxpex::LruCache<int, std::string> cache(2);
+    size_t createCount = 0;
+
+    auto create = [&createCount]()
+    {
+        ++createCount;
+        return std::to_string(createCount);
+    };
+
+    REQUIRE(cache.Get(1, create) == "1");
+    REQUIRE(cache.Get(2, create) == "2");
+
+    // Using 1 makes 2 the least recently used.
+    REQUIRE(cache.Get(1, create) == "1");
+    REQUIRE(cache.Get(3, create) == "3");
+
+    REQUIRE(cache.GetCount() == 2);
+    REQUIRE(cache.Contains(1));
+    REQUIRE(!cache.Contains(2));
+    REQUIRE(cache.Contains(3));
+
+    auto statistics = cache.GetStatistics();
+    REQUIRE(statistics.hits == 1);
+    REQUIRE(statistics.misses == 3);
+    REQUIRE(statistics.evictions == 1);
+    REQUIRE(statistics.GetHitRate() == Approx(0.25));
+
+    REQUIRE_THROWS_AS(
+        (wxpex::LruCache<int, int>(0)),
+        std::invalid_argument);
+}
+
+
+TEST_CASE("Graphics resources are reused", "[resource_cache]")
+{
+    auto renderer = wxGraphicsRenderer::GetDefaultRenderer();
+    wxpex::GraphicsResourceCache cache(renderer, 4);
+
+    auto red = wxColour(255, 0, 0);
+    auto blue = wxColour(0, 0, 255);
+
+    cache.GetPen(red, 2.0);
+    cache.GetPen(red, 2.0);
+    cache.GetPen(red, 2.0, wxpex::PenStyle::dot);
+    cache.GetBrush(blue);
+    cache.GetBrush(blue);
+
+    wxGraphicsGradientStops stops(red, blue);
+    stops.Add(wxColour(0, 255, 0), 0.5f);
+
+    cache.GetLinearGradientBrush(0.0, 0.0, 10.0, 10.0, stops);
+    cache.GetLinearGradientBrush(0.0, 0.0, 10.0, 10.0, stops);
+
+    REQUIRE(cache.GetCount() == 4);
+
+    auto statistics = cache.GetStatistics();
+    REQUIRE(statistics.hits == 3);
+    REQUIRE(statistics.misses == 4);
+    REQUIRE(statistics.GetHitRate() == Approx(3.0 / 7.0));
+
+    REQUIRE(&wxpex::GraphicsResourceCache::Get(renderer)
+        == &wxpex::GraphicsResourceCache::Get(renderer));
+}
+
+
+TEST_CASE("Shared caches can be released", "[resource_cache]")
+{
+    auto renderer = wxGraphicsRenderer::GetDefaultRenderer();
+
+    wxpex::GraphicsResourceCache::Get(renderer).GetBrush(*wxRED);
+    REQUIRE(wxpex::GraphicsResourceCache::Get(renderer).GetCount() == 1);
+
+    wxpex::GraphicsResourceCache::Release(renderer);
+    REQUIRE(wxpex::GraphicsResourceCache::Get(renderer).GetCount() == 0);
+
+    wxpex::GraphicsResourceCache::Get(renderer).GetBrush(*wxRED);
+    wxpex::GraphicsResourceCache::ReleaseAll();
+    REQUIRE(wxpex::GraphicsResourceCache::Get(renderer).GetCount() == 0);
+
+    // Releasing a renderer without a cache does nothing.
+    wxpex::GraphicsResourceCache::ReleaseAll();
+    wxpex::GraphicsResourceCache::Release(renderer);
+}
@@ -0,0 +1,202 @@
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <wxpex/polygon_batch.h>
+
+
+polygon::Recipe MakeRecipe(size_t sideCount, double sideLength)
+{
+    polygon::Recipe recipe;
+    recipe.sideCount = sideCount;
+    recipe.sideLength = sideLength;
+
+    return recipe;
+}
+
+
+TEST_CASE("Square recipe", "[shape]")
+{
+    auto recipe = MakeRecipe(4, 10.0);
+    recipe.position = polygon::Point(100.0, 100.0);
+
+    auto square = polygon::Polygon(recipe);
+    auto bounds = square.GetBounds();
+
+    REQUIRE(square.GetPoints().size() == 4);
+    REQUIRE(bounds.left == Approx(95.0));
+    REQUIRE(bounds.top == Approx(95.0));
+    REQUIRE(bounds.right == Approx(105.0));
+    REQUIRE(bounds.bottom == Approx(105.0));
+
+    REQUIRE(square.Contains(polygon::Point(100.0, 100.0)));
+    REQUIRE(square.Contains(polygon::Point(104.9, 95.1)));
+    REQUIRE(!square.Contains(polygon::Point(105.1, 100.0)));
+    REQUIRE(!square.Contains(polygon::Point(100.0, 94.9)));
+}
+
+
+TEST_CASE("Rotated triangle", "[shape]")
+{
+    auto recipe = MakeRecipe(3, 30.0);
+    recipe.rotation_deg = 180.0;
+
+    auto triangle = polygon::Polygon(recipe);
+
+    // Rotated to point up, so the top of the bounds is a vertex, and the
+    // middle of the base is below the center.
+    auto apothem = 30.0 / (2.0 * std::tan(tau::ToRadians(60.0)));
+
+    REQUIRE(triangle.Contains(polygon::Point(0.0, apothem - 0.01)));
+    REQUIRE(!triangle.Contains(polygon::Point(0.0, apothem + 0.01)));
+    REQUIRE(triangle.GetBounds().bottom == Approx(apothem));
+}
+
+
+TEST_CASE("Sides are equal for large side counts", "[shape]")
+{
+    auto recipe = MakeRecipe(1024, 2.0);
+    auto vertices = recipe.GetVertices();
+
+    REQUIRE(vertices.size() == 1024);
+
+    auto previous = vertices.back();
+
+    for (auto &vertex: vertices)
+    {
+        auto length = std::hypot(vertex.x - previous.x, vertex.y - previous.y);
+        REQUIRE(length == Approx(2.0));
+        previous = vertex;
+    }
+}
+
+
+TEST_CASE("Geometry is shared between positions", "[shape]")
+{
+    polygon::GeometryCache cache;
+
+    auto first = MakeRecipe(6, 10.0);
+    auto second = first;
+    second.position = polygon::Point(50.0, -20.0);
+
+    auto firstPolygon = cache.MakePolygon(first);
+    auto secondPolygon = cache.MakePolygon(second);
+
+    REQUIRE(cache.GetCount() == 1);
+
+    REQUIRE(
+        secondPolygon.GetBounds().left
+            == Approx(firstPolygon.GetBounds().left + 50.0));
+
+    second.rotation_deg = 10.0;
+    cache.MakePolygon(second);
+
+    REQUIRE(cache.GetCount() == 2);
+}
+
+
+TEST_CASE("Geometry cache is bounded by its capacity", "[shape]")
+{
+    polygon::GeometryCache cache(8);
+
+    auto recipe = MakeRecipe(4, 2.0);
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        recipe.rotation_deg = static_cast<double>(i);
+        cache.MakePolygon(recipe);
+    }
+
+    REQUIRE(cache.GetCapacity() == 8);
+    REQUIRE(cache.GetCount() == 8);
+}
+
+
+TEST_CASE("Batch groups polygons by style", "[shape]")
+{
+    polygon::PolygonBatch batch;
+
+    auto red = polygon::Style{{{255, 0, 0, 255}}, wxpex::Composition::over};
+    auto blue = polygon::Style{{{0, 0, 255, 128}}, wxpex::Composition::over};
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        auto recipe = MakeRecipe(5, 4.0);
+        recipe.position = polygon::Point(static_cast<double>(i) * 10.0, 0.0);
+        batch.Add(recipe, (i % 2) ? red : blue);
+    }
+
+    REQUIRE(batch.GetCount() == 100);
+    REQUIRE(batch.GetStyleCount() == 2);
+    REQUIRE(batch.GetGeometryCache().GetCount() == 1);
+}
+
+
+static std::vector<polygon::Point> MakeGrid(double extent, size_t countPerSide)
+{
+    std::vector<polygon::Point> result;
+    result.reserve(countPerSide * countPerSide);
+
+    auto step = 2.0 * extent / static_cast<double>(countPerSide - 1);
+
+    for (size_t row = 0; row < countPerSide; ++row)
+    {
+        for (size_t column = 0; column < countPerSide; ++column)
+        {
+            result.emplace_back(
+                -extent + static_cast<double>(column) * step,
+                -extent + static_cast<double>(row) * step);
+        }
+    }
+
+    return result;
+}
+
+
+TEST_CASE("ContainsMany matches Contains", "[shape]")
+{
+    auto sideCount = GENERATE(3u, 5u, 64u, 1024u);
+    auto recipe = MakeRecipe(sideCount, 1000.0 / sideCount);
+    recipe.rotation_deg = 17.0;
+
+    auto polygon = polygon::Polygon(recipe);
+    auto points = MakeGrid(polygon.GetBounds().right * 1.2, 45);
+    auto mask = polygon.ContainsMany(points);
+
+    REQUIRE(mask.size() == (points.size() + 63) / 64);
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        REQUIRE(
+            polygon::Polygon::IsSet(mask, i) == polygon.Contains(points[i]));
+    }
+}
+
+
+TEST_CASE("Polygon kernels", "[.benchmark]")
+{
+    auto recipe = MakeRecipe(1024, 1.0);
+    auto polygon = polygon::Polygon(recipe);
+    auto points = MakeGrid(polygon.GetBounds().right, 100);
+
+    BENCHMARK("Generate 1024 vertices")
+    {
+        return recipe.GetVertices();
+    };
+
+    BENCHMARK("Contains, one point at a time")
+    {
+        size_t count = 0;
+
+        for (auto &point: points)
+        {
+            count += polygon.Contains(point);
+        }
+
+        return count;
+    };
+
+    BENCHMARK("ContainsMany")
+    {
+        return polygon.ContainsMany(points);
+    };
+}
@@ -0,0 +1,168 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <wxpex/spatial_index.h>
+
+
+static polygon::Polygon MakeSquare(double x, double y, double side)
+{
+    polygon::Recipe recipe;
+    recipe.sideCount = 4;
+    recipe.sideLength = side;
+    recipe.position = polygon::Point(x, y);
+
+    return polygon::Polygon(recipe);
+}
+
+
+TEST_CASE("Pick returns the topmost polygon", "[spatial_index]")
+{
+    polygon::SpatialIndex index(16.0);
+
+    auto bottom = index.Insert(MakeSquare(50.0, 50.0, 40.0));
+    auto top = index.Insert(MakeSquare(60.0, 60.0, 20.0));
+
+    REQUIRE(index.GetCount() == 2);
+    REQUIRE(index.Pick(polygon::Point(60.0, 60.0)) == top);
+    REQUIRE(index.Pick(polygon::Point(35.0, 35.0)) == bottom);
+    REQUIRE(!index.Pick(polygon::Point(100.0, 100.0)));
+
+    auto both = index.QueryPoint(polygon::Point(60.0, 60.0));
+    std::sort(both.begin(), both.end());
+    REQUIRE(both == std::vector<polygon::SpatialIndex::Id>{bottom, top});
+}
+
+
+TEST_CASE("Update and remove polygons", "[spatial_index]")
+{
+    polygon::SpatialIndex index(16.0);
+
+    auto first = index.Insert(MakeSquare(50.0, 50.0, 20.0));
+    auto second = index.Insert(MakeSquare(200.0, 200.0, 20.0));
+
+    index.Update(first, MakeSquare(200.0, 200.0, 10.0));
+    REQUIRE(!index.Pick(polygon::Point(50.0, 50.0)));
+
+    // Updating keeps the stacking order.
+    REQUIRE(index.Pick(polygon::Point(200.0, 200.0)) == second);
+
+    index.Remove(second);
+    REQUIRE(index.GetCount() == 1);
+    REQUIRE(index.Pick(polygon::Point(200.0, 200.0)) == first);
+
+    REQUIRE_THROWS_AS(index.Remove(second), std::out_of_range);
+    REQUIRE_THROWS_AS(index.Get(second), std::out_of_range);
+}
+
+
+TEST_CASE("Queries match a linear scan", "[spatial_index]")
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> coordinate(-500.0, 500.0);
+    std::uniform_real_distribution<double> side(1.0, 80.0);
+
+    polygon::SpatialIndex index(32.0);
+    std::vector<polygon::Polygon> polygons;
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        auto x = coordinate(generator);
+        auto y = coordinate(generator);
+        polygons.push_back(MakeSquare(x, y, side(generator)));
+
+        REQUIRE(index.Insert(polygons.back()) == i);
+    }
+
+    for (size_t i = 0; i < 200; ++i)
+    {
+        auto x = coordinate(generator);
+        auto y = coordinate(generator);
+        auto point = polygon::Point(x, y);
+
+        std::optional<polygon::SpatialIndex::Id> expected;
+
+        for (size_t id = 0; id < polygons.size(); ++id)
+        {
+            if (polygons[id].Contains(point))
+            {
+                expected = id;
+            }
+        }
+
+        REQUIRE(index.Pick(point) == expected);
+    }
+
+    polygon::Bounds viewport{-100.0, -50.0, 150.0, 75.0};
+    std::vector<polygon::SpatialIndex::Id> expected;
+
+    for (size_t id = 0; id < polygons.size(); ++id)
+    {
+        if (polygons[id].GetBounds().Intersects(viewport))
+        {
+            expected.push_back(id);
+        }
+    }
+
+    auto found = index.QueryBounds(viewport);
+    std::sort(found.begin(), found.end());
+
+    REQUIRE(found == expected);
+}
+
+
+TEST_CASE("Huge and non-finite bounds", "[spatial_index]")
+{
+    polygon::SpatialIndex index(16.0);
+
+    auto small = index.Insert(MakeSquare(0.0, 0.0, 10.0));
+
+    // Far enough apart that truncated cell indices would share a key.
+    auto farAway = static_cast<double>(int64_t(1) << 36);
+    auto distant = index.Insert(MakeSquare(farAway, 0.0, 10.0));
+
+    // Spans far more cells than are listed individually.
+    auto huge = index.Insert(MakeSquare(0.0, 0.0, 1e300));
+
+    REQUIRE(index.Pick(polygon::Point(0.0, 0.0)) == huge);
+    REQUIRE(index.Pick(polygon::Point(1e200, 0.0)) == huge);
+
+    auto near = index.QueryPoint(polygon::Point(0.0, 0.0));
+    std::sort(near.begin(), near.end());
+    REQUIRE(near == std::vector<polygon::SpatialIndex::Id>{small, huge});
+
+    auto far = index.QueryPoint(polygon::Point(farAway, 0.0));
+    std::sort(far.begin(), far.end());
+    REQUIRE(far == std::vector<polygon::SpatialIndex::Id>{distant, huge});
+
+    auto all = index.QueryBounds({-1e250, -1e250, 1e250, 1e250});
+    std::sort(all.begin(), all.end());
+
+    REQUIRE(
+        all == std::vector<polygon::SpatialIndex::Id>{small, distant, huge});
+
+    index.Update(huge, MakeSquare(100.0, 100.0, 10.0));
+    REQUIRE(index.Pick(polygon::Point(1e200, 0.0)) == std::nullopt);
+    REQUIRE(index.Pick(polygon::Point(100.0, 100.0)) == huge);
+
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+    auto infinity = std::numeric_limits<double>::infinity();
+
+    REQUIRE_THROWS_AS(
+        index.Insert(MakeSquare(nan, 0.0, 10.0)),
+        std::invalid_argument);
+
+    REQUIRE_THROWS_AS(
+        index.Update(small, MakeSquare(infinity, 0.0, 10.0)),
+        std::invalid_argument);
+
+    REQUIRE_THROWS_AS(
+        index.QueryBounds({0.0, 0.0, infinity, 1.0}),
+        std::invalid_argument);
+
+    REQUIRE(index.GetCount() == 3);
+    REQUIRE(index.Pick(polygon::Point(0.0, 0.0)) == small);
+    REQUIRE(!index.Pick(polygon::Point(nan, 0.0)));
+    REQUIRE(index.QueryPoint(polygon::Point(infinity, 0.0)).empty());
+}
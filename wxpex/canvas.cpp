@@ -0,0 +1,184 @@
+#include "wxpex/canvas.h"
+
+#include "wxpex/ignores.h"
+#include "wxpex/paint_profiler.h"
+
+WXSHIM_PUSH_IGNORES
+#include <wx/dcmemory.h>
+WXSHIM_POP_IGNORES
+
+
+namespace wxpex
+{
+
+
+namespace
+{
+
+
+int RoundUp(int value, int granularity)
+{
+    return ((value + granularity - 1) / granularity) * granularity;
+}
+
+
+} // end anonymous namespace
+
+
+Canvas::Canvas(
+    wxWindow *parent,
+    wxWindowID id,
+    const wxPoint &position,
+    const wxSize &size,
+    long style)
+    :
+    wxWindow(parent, id, position, size, style),
+    backing_(),
+    backingSize_(),
+    backingScale_(1.0),
+    stale_()
+{
+    // Every pixel is copied from the backing bitmap in OnPaint_.
+    this->SetBackgroundStyle(wxBG_STYLE_PAINT);
+
+    this->Bind(wxEVT_PAINT, &Canvas::OnPaint_, this);
+    this->Bind(wxEVT_SIZE, &Canvas::OnSize_, this);
+    this->Bind(wxEVT_DPI_CHANGED, &Canvas::OnDpiChanged_, this);
+}
+
+
+void Canvas::Refresh(bool, const wxRect *rect)
+{
+    auto stale = rect ? *rect : wxRect(this->GetClientSize());
+
+    if (this->stale_)
+    {
+        this->stale_->Union(stale);
+    }
+    else
+    {
+        this->stale_ = stale;
+    }
+
+    wxWindow::Refresh(false, rect);
+}
+
+
+wxSize Canvas::GetBackingSize() const
+{
+    return this->backingSize_;
+}
+
+
+void Canvas::OnCanvasResized_(const wxSize &)
+{
+    this->Refresh(false);
+}
+
+
+wxColour Canvas::GetCanvasBackground_() const
+{
+    return this->GetBackgroundColour();
+}
+
+
+void Canvas::OnPaint_(wxPaintEvent &)
+{
+    PROFILE_PAINT(this)
+
+    this->UpdateBacking_();
+
+    if (this->stale_)
+    {
+        auto stale = this->stale_->Intersect(wxRect(this->GetClientSize()));
+        this->stale_.reset();
+
+        if (!stale.IsEmpty())
+        {
+            wxMemoryDC memoryDc(this->backing_);
+            GraphicsContext context(memoryDc);
+
+            context->Clip(stale.x, stale.y, stale.width, stale.height);
+
+            context->SetPen(wxNullPen);
+            context->SetBrush(wxBrush(this->GetCanvasBackground_()));
+
+            context->DrawRectangle(
+                stale.x,
+                stale.y,
+                stale.width,
+                stale.height);
+
+            this->DrawCanvas_(context, stale);
+
+            // The context is flushed to the backing bitmap when it is
+            // destroyed, before the bitmap is copied to the window.
+        }
+    }
+
+    // The paint DC is clipped to the update region, so only the exposed and
+    // stale areas are copied.
+    wxPaintDC dc(this);
+    dc.DrawBitmap(this->backing_, 0, 0);
+
+    if (PaintProfiler::IsOverlayEnabled())
+    {
+        GraphicsContext context(dc);
+        PaintProfiler::DrawOverlay(context, this);
+    }
+}
+
+
+void Canvas::OnSize_(wxSizeEvent &event)
+{
+    event.Skip();
+    this->OnCanvasResized_(this->GetClientSize());
+}
+
+
+void Canvas::OnDpiChanged_(wxDPIChangedEvent &event)
+{
+    event.Skip();
+
+    // The backing bitmap is reallocated at the new scale on the next paint.
+    this->Refresh(false);
+}
+
+
+void Canvas::UpdateBacking_()
+{
+    auto clientSize = this->GetClientSize();
+    clientSize.IncTo(wxSize(1, 1));
+
+    auto scale = this->GetContentScaleFactor();
+
+    auto fits = [&](int client, int backing) -> bool
+    {
+        // Shrinking far below the backing size releases the memory.
+        return client <= backing
+            && backing <= 2 * client + backingGranularity;
+    };
+
+    if (
+        this->backing_.IsOk()
+        && scale == this->backingScale_
+        && fits(clientSize.GetWidth(), this->backingSize_.GetWidth())
+        && fits(clientSize.GetHeight(), this->backingSize_.GetHeight()))
+    {
+        return;
+    }
+
+    this->backingSize_ = wxSize(
+        RoundUp(clientSize.GetWidth(), backingGranularity),
+        RoundUp(clientSize.GetHeight(), backingGranularity));
+
+    this->backingScale_ = scale;
+    this->backing_ = wxBitmap();
+    this->backing_.CreateWithDIPSize(this->backingSize_, scale);
+
+    // The new bitmap holds nothing that can be copied to the window.
+    this->stale_ = wxRect(clientSize);
+}
+
+
+} // end namespace wxpex
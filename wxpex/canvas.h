@@ -0,0 +1,92 @@
+#pragma once
+
+
+#include <optional>
+
+#include "wxpex/wxshim.h"
+#include "wxpex/graphics.h"
+
+
+namespace wxpex
+{
+
+
+/**
+ ** A custom-painted window that keeps its pixels in a persistent backing
+ ** bitmap.
+ **
+ ** Subclasses draw in DrawCanvas_, which is only called for the areas that
+ ** have been invalidated with Refresh or RefreshRect since the last paint.
+ ** Paints caused by exposure, such as another window moving away, copy the
+ ** backing bitmap without drawing anything.
+ **
+ ** The backing bitmap matches the display's scale factor, and grows in steps
+ ** of backingGranularity so that resizing does not reallocate on every size
+ ** event.
+ **
+ ** Must only be used from the wx event loop thread.
+ **/
+class Canvas: public wxWindow
+{
+public:
+    static constexpr int backingGranularity = 64;
+
+    Canvas(
+        wxWindow *parent,
+        wxWindowID id = wxID_ANY,
+        const wxPoint &position = wxDefaultPosition,
+        const wxSize &size = wxDefaultSize,
+        long style = 0);
+
+    /**
+     ** Marks rect, or the whole client area, as stale in the backing bitmap
+     ** as well as on screen. The background is never erased, because every
+     ** stale pixel is cleared before DrawCanvas_ is called.
+     **/
+    void Refresh(
+        bool eraseBackground = true,
+        const wxRect *rect = nullptr) override;
+
+    // The logical size of the backing bitmap, which is at least the client
+    // size once the canvas has been painted.
+    wxSize GetBackingSize() const;
+
+protected:
+    /**
+     ** Draws the stale area of the canvas.
+     **
+     ** The context is clipped to stale, which has already been filled with
+     ** GetCanvasBackground_().
+     **/
+    virtual void DrawCanvas_(GraphicsContext &context, const wxRect &stale) = 0;
+
+    // The color of stale areas before DrawCanvas_. The default is the
+    // background color of this window.
+    virtual wxColour GetCanvasBackground_() const;
+
+    /**
+     ** Called when the client size changes. The default invalidates the whole
+     ** canvas. Subclasses that anchor their drawing to the top left corner
+     ** may invalidate only the newly exposed area instead.
+     **/
+    virtual void OnCanvasResized_(const wxSize &clientSize);
+
+private:
+    void OnPaint_(wxPaintEvent &);
+
+    void OnSize_(wxSizeEvent &event);
+
+    void OnDpiChanged_(wxDPIChangedEvent &event);
+
+    // Reallocates the backing bitmap when it no longer fits the client area
+    // or the scale factor.
+    void UpdateBacking_();
+
+    wxBitmap backing_;
+    wxSize backingSize_;
+    double backingScale_;
+    std::optional<wxRect> stale_;
+};
+
+
+} // end namespace wxpex
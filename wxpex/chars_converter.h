@@ -0,0 +1,336 @@
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <pex/converter.h>
+
+#include "wxpex/wxshim.h"
+
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+// The standard library supports std::to_chars and std::from_chars for
+// floating-point types.
+#define WXPEX_HAS_FLOATING_TO_CHARS
+#endif
+
+
+namespace wxpex
+{
+
+
+/**
+ ** A numeric converter with the same interface as pex::Converter, formatted
+ ** with std::to_chars into a fixed-capacity buffer on the stack.
+ **
+ ** ToString produces a wxString directly from the buffer, without an
+ ** intermediate std::string, so it is suitable for readouts that update at
+ ** a high rate (see View).
+ **
+ ** Traits follow the printf conventions used by ViewTraits:
+ **
+ **     width: Minimum field width. Shorter values are padded with leading
+ **         spaces.
+ **
+ **     precision: For floating-point types, the number of digits after the
+ **         decimal point. A negative precision selects the shortest
+ **         representation that round-trips.
+ **         For integral types, the minimum number of digits, padded with
+ **         leading zeros.
+ **
+ **     base: The radix for integral types (lowercase digits, no prefix).
+ **/
+template<typename T, typename Traits = pex::DefaultConverterTraits>
+struct CharsConverter
+{
+    static_assert(
+        std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+        "CharsConverter only supports numeric types");
+
+    static constexpr int base = Traits::base;
+    static constexpr int width = Traits::width;
+    static constexpr int precision = Traits::precision;
+
+    static_assert(
+        std::is_floating_point_v<T> || (base >= 2 && base <= 36),
+        "Unsupported base");
+
+    // Room for the digits of the widest value, the sign, and the padding
+    // requested by Traits.
+    static constexpr size_t digitsCapacity =
+        std::is_floating_point_v<T> ? 128 : 72;
+
+    static constexpr size_t capacity =
+        digitsCapacity
+        + static_cast<size_t>(std::max(0, width))
+        + static_cast<size_t>(std::max(0, precision));
+
+    using Buffer = std::array<char, capacity>;
+
+    /**
+     ** Format value into buffer.
+     **
+     ** @return The number of characters written. The result is not
+     ** null-terminated.
+     **/
+    static size_t Format(Buffer &buffer, T value)
+    {
+        std::array<char, digitsCapacity> digits;
+        size_t digitsCount = FormatDigits_(digits, value);
+
+        size_t signCount = (digitsCount > 0 && digits[0] == '-') ? 1 : 0;
+        size_t zeroCount = 0;
+
+        if constexpr (std::is_integral_v<T>)
+        {
+            size_t minimumDigits = static_cast<size_t>(std::max(0, precision));
+            size_t valueDigits = digitsCount - signCount;
+
+            if (minimumDigits > valueDigits)
+            {
+                zeroCount = minimumDigits - valueDigits;
+            }
+        }
+
+        size_t total = digitsCount + zeroCount;
+        size_t padCount = 0;
+
+        if (static_cast<size_t>(std::max(0, width)) > total)
+        {
+            padCount = static_cast<size_t>(width) - total;
+        }
+
+        auto output = buffer.data();
+
+        for (size_t i = 0; i < padCount; ++i)
+        {
+            *output++ = ' ';
+        }
+
+        if (signCount)
+        {
+            *output++ = '-';
+        }
+
+        for (size_t i = 0; i < zeroCount; ++i)
+        {
+            *output++ = '0';
+        }
+
+        for (size_t i = signCount; i < digitsCount; ++i)
+        {
+            *output++ = digits[i];
+        }
+
+        return static_cast<size_t>(output - buffer.data());
+    }
+
+    static wxString ToString(T value)
+    {
+        Buffer buffer;
+        size_t count = Format(buffer, value);
+
+        return wxString::FromAscii(buffer.data(), count);
+    }
+
+    /**
+     ** Parse a value formatted by ToString.
+     **
+     ** Throws std::invalid_argument or std::out_of_range, like std::stod and
+     ** friends.
+     **/
+    static T ToValue(const std::string &asString)
+    {
+        auto first = asString.data();
+        auto last = first + asString.size();
+
+        while (first != last && (*first == ' ' || *first == '\t'))
+        {
+            ++first;
+        }
+
+        if (first != last && *first == '+')
+        {
+            ++first;
+        }
+
+        T result{};
+        std::from_chars_result parsed{};
+
+        if constexpr (std::is_integral_v<T>)
+        {
+            if constexpr (base == 16)
+            {
+                if (
+                    (last - first) > 2
+                    && first[0] == '0'
+                    && (first[1] == 'x' || first[1] == 'X'))
+                {
+                    first += 2;
+                }
+            }
+
+            parsed = std::from_chars(first, last, result, base);
+        }
+        else
+        {
+#ifdef WXPEX_HAS_FLOATING_TO_CHARS
+            parsed = std::from_chars(first, last, result);
+#else
+            // The std::string overloads would copy the input.
+            char *end = nullptr;
+            errno = 0;
+            auto parsedValue = std::strtold(first, &end);
+            parsed.ptr = end;
+
+            if (end == first)
+            {
+                parsed.ec = std::errc::invalid_argument;
+            }
+            else if (
+                errno == ERANGE
+                || parsedValue > std::numeric_limits<T>::max()
+                || parsedValue < std::numeric_limits<T>::lowest())
+            {
+                parsed.ec = std::errc::result_out_of_range;
+            }
+            else
+            {
+                result = static_cast<T>(parsedValue);
+            }
+#endif
+        }
+
+        if (parsed.ec == std::errc::invalid_argument)
+        {
+            throw std::invalid_argument("Unable to convert: " + asString);
+        }
+
+        if (parsed.ec == std::errc::result_out_of_range)
+        {
+            throw std::out_of_range("Value out of range: " + asString);
+        }
+
+        auto remaining = parsed.ptr;
+
+        while (remaining != last && (*remaining == ' ' || *remaining == '\t'))
+        {
+            ++remaining;
+        }
+
+        if (remaining != last)
+        {
+            throw std::invalid_argument("Unable to convert: " + asString);
+        }
+
+        return result;
+    }
+
+private:
+    static size_t FormatDigits_(
+        std::array<char, digitsCapacity> &digits,
+        T value)
+    {
+        auto first = digits.data();
+        auto last = first + digits.size();
+
+        if constexpr (std::is_integral_v<T>)
+        {
+            auto result = std::to_chars(first, last, value, base);
+
+            // digitsCapacity holds any integer in any base.
+            assert(result.ec == std::errc());
+
+            return static_cast<size_t>(result.ptr - first);
+        }
+        else
+        {
+#ifdef WXPEX_HAS_FLOATING_TO_CHARS
+            std::to_chars_result result{};
+
+            if constexpr (precision >= 0)
+            {
+                result = std::to_chars(
+                    first,
+                    last,
+                    value,
+                    std::chars_format::fixed,
+                    precision);
+
+                if (result.ec == std::errc::value_too_large)
+                {
+                    // Very large magnitudes do not fit in fixed notation.
+                    result = std::to_chars(
+                        first,
+                        last,
+                        value,
+                        std::chars_format::scientific,
+                        precision);
+                }
+            }
+            else
+            {
+                result = std::to_chars(first, last, value);
+            }
+
+            if (result.ec != std::errc())
+            {
+                return 0;
+            }
+
+            return static_cast<size_t>(result.ptr - first);
+#else
+            int count;
+
+            if constexpr (precision >= 0)
+            {
+                count = std::snprintf(
+                    first,
+                    digits.size(),
+                    "%.*f",
+                    precision,
+                    static_cast<double>(value));
+
+                if (count < 0 || static_cast<size_t>(count) >= digits.size())
+                {
+                    count = std::snprintf(
+                        first,
+                        digits.size(),
+                        "%.*e",
+                        precision,
+                        static_cast<double>(value));
+                }
+            }
+            else
+            {
+                count = std::snprintf(
+                    first,
+                    digits.size(),
+                    "%.*g",
+                    std::numeric_limits<T>::max_digits10,
+                    static_cast<double>(value));
+            }
+
+            if (count < 0)
+            {
+                return 0;
+            }
+
+            return std::min(static_cast<size_t>(count), digits.size() - 1);
+#endif
+        }
+    }
+};
+
+
+} // end namespace wxpex
@@ -13,6 +13,7 @@
 
 #include "wxpex/wxshim.h"
 #include <pex/value.h>
+#include "wxpex/startup_profiler.h"
 
 
 namespace wxpex
@@ -45,6 +46,7 @@ public:
     {
         this->SetValue(this->value_.Get());
         this->value_.Connect(&CheckBox::OnValueChanged_);
+        PROFILE_WIDGET_CONNECTED(this)
         this->Bind(wxEVT_CHECKBOX, &CheckBox::OnCheckBox_, this);
     }
 
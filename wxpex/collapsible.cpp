@@ -1,3 +1,5 @@
+#include <deque>
+#include <algorithm>
 #include <jive/scope_flag.h>
 #include "wxpex/collapsible.h"
 #include "wxpex/layout_top_level.h"
@@ -14,6 +16,12 @@ namespace wxpex
 {
 
 
+// Panes waiting to create their content on idle, in the order they were
+// requested. Only one is created on each idle event, so that the cost is spread
+// across iterations of the event loop.
+static std::deque<Collapsible *> idleContent_;
+
+
 Collapsible::Collapsible(
     wxWindow *parent,
     const std::string &label,
@@ -31,7 +39,9 @@ Collapsible::Collapsible(
     label_(label),
     stateEndpoint_(),
     hasStateEndpoint_(false),
-    ignoreState_(false)
+    ignoreState_(false),
+    contentFactory_(),
+    isWaitingForIdle_(false)
 {
     REGISTER_PEX_NAME(this, "wxpex::Collapsible");
     REGISTER_WIDGET_NAME(this, label);
@@ -81,6 +91,12 @@ Collapsible::Collapsible(
 }
 
 
+Collapsible::~Collapsible()
+{
+    this->CancelIdle_();
+}
+
+
 wxWindow * Collapsible::GetPanel()
 {
     if (this->borderPane_)
@@ -151,6 +167,114 @@ void Collapsible::ConfigureSizer(std::unique_ptr<wxSizer> &&sizer)
 }
 
 
+void Collapsible::SetContentFactory(
+    const ContentFactory &contentFactory,
+    LazyContent lazyContent)
+{
+    if (this->IsExpanded())
+    {
+        this->ConfigureSizer(contentFactory(this->GetPanel()));
+
+        return;
+    }
+
+    this->contentFactory_ = contentFactory;
+
+    if (lazyContent == LazyContent::onIdle && !this->isWaitingForIdle_)
+    {
+        idleContent_.push_back(this);
+        this->isWaitingForIdle_ = true;
+        this->Bind(wxEVT_IDLE, &Collapsible::OnIdle_, this);
+    }
+}
+
+
+bool Collapsible::HasContent() const
+{
+    return !this->contentFactory_;
+}
+
+
+void Collapsible::CreateContent()
+{
+    if (!this->contentFactory_)
+    {
+        return;
+    }
+
+    this->CancelIdle_();
+
+    // Release the factory before running it, along with anything it has
+    // captured.
+    ContentFactory contentFactory;
+    std::swap(contentFactory, this->contentFactory_);
+
+    this->ConfigureSizer(contentFactory(this->GetPanel()));
+}
+
+
+void Collapsible::Collapse(bool collapse)
+{
+    if (!collapse)
+    {
+        this->CreateContent();
+    }
+
+    this->wxCollapsiblePane::Collapse(collapse);
+}
+
+
+void Collapsible::OnIdle_(wxIdleEvent &event)
+{
+    event.Skip();
+
+    // Panes that are not shown yet (for example, on a hidden page of
+    // a notebook) wait their turn without blocking the others.
+    auto next = std::find_if(
+        std::begin(idleContent_),
+        std::end(idleContent_),
+        [](Collapsible *collapsible) -> bool
+        {
+            return collapsible->IsShownOnScreen();
+        });
+
+    if (next == std::end(idleContent_) || *next != this)
+    {
+        return;
+    }
+
+    {
+        Freezer freezer(this);
+        this->CreateContent();
+
+        // The pane is collapsed, but its best width includes the content.
+        this->FixLayout();
+    }
+
+    if (!idleContent_.empty())
+    {
+        // Continue with the next pane without waiting for another event.
+        event.RequestMore();
+    }
+}
+
+
+void Collapsible::CancelIdle_()
+{
+    if (!this->isWaitingForIdle_)
+    {
+        return;
+    }
+
+    this->Unbind(wxEVT_IDLE, &Collapsible::OnIdle_, this);
+    this->isWaitingForIdle_ = false;
+
+    idleContent_.erase(
+        std::remove(std::begin(idleContent_), std::end(idleContent_), this),
+        std::end(idleContent_));
+}
+
+
 void Collapsible::UpdateMinimumSize_() const
 {
     if (this->borderPane_)
@@ -205,6 +329,11 @@ wxSize Collapsible::DoGetBestClientSize() const
 
 void Collapsible::HandleStateChange_()
 {
+    if (this->IsExpanded())
+    {
+        this->CreateContent();
+    }
+
     this->FixLayout();
 
     if (this->ignoreState_)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <functional>
 
 #include <pex/model_value.h>
 #include <pex/control_value.h>
@@ -19,12 +20,31 @@ namespace wxpex
 {
 
 
+enum class LazyContent
+{
+    // Create the content the first time the pane is expanded.
+    onExpand,
+
+    // Create the content when the application is idle after the window has
+    // been shown, one pane per idle event, or on first expansion, whichever
+    // comes first.
+    onIdle
+};
+
+
 class Collapsible: public wxCollapsiblePane, public Expandable
 {
 public:
     using StateModel = pex::model::Value<bool>;
     using StateControl = pex::control::Value<StateModel>;
 
+    /**
+     ** Creates the widgets of the pane, parented to panel, and returns the
+     ** sizer to pass to ConfigureSizer.
+     **/
+    using ContentFactory =
+        std::function<std::unique_ptr<wxSizer> (wxWindow *panel)>;
+
     static constexpr auto observerName = "wxpex::Collapsible";
 
     Collapsible(
@@ -38,8 +58,34 @@ public:
         const std::string &label,
         long borderStyle = wxBORDER_NONE);
 
+    ~Collapsible();
+
     void ConfigureSizer(std::unique_ptr<wxSizer> &&sizer);
 
+    /**
+     ** Defer construction of the pane's content, and of any pex endpoints it
+     ** creates, until the pane is needed.
+     **
+     ** Use in place of ConfigureSizer. If the pane is already expanded, the
+     ** content is created immediately.
+     **/
+    void SetContentFactory(
+        const ContentFactory &contentFactory,
+        LazyContent lazyContent = LazyContent::onExpand);
+
+    // Returns false while a content factory is waiting to run.
+    bool HasContent() const;
+
+    // Run the pending content factory now.
+    void CreateContent();
+
+    /**
+     ** Runs the pending content factory before expanding, because expanding
+     ** the pane programmatically, including with Expand(), does not send
+     ** wxEVT_COLLAPSIBLEPANE_CHANGED.
+     **/
+    void Collapse(bool collapse = true) override;
+
 #if 1
 #if defined(__WXGTK__)
     // WXGTK uses DoGetBestSize, and WXMAC/WXMSW ignore it.
@@ -65,6 +111,10 @@ private:
 
     void HandleStateChange_();
 
+    void OnIdle_(wxIdleEvent &);
+
+    void CancelIdle_();
+
     wxPanel *borderPane_;
     std::string label_;
 
@@ -72,6 +122,8 @@ private:
     StateEndpoint stateEndpoint_;
     bool hasStateEndpoint_;
     bool ignoreState_;
+    ContentFactory contentFactory_;
+    bool isWaitingForIdle_;
 };
 
 
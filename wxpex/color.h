@@ -6,6 +6,7 @@
 #include <pex/endpoint.h>
 #include "wxpex/slider.h"
 #include "wxpex/labeled_widget.h"
+#include "wxpex/damage.h"
 
 
 namespace wxpex
@@ -69,19 +70,30 @@ public:
         wxSize size = wxSize(65, 65))
         :
         wxPanel(parent, wxID_ANY, wxDefaultPosition, size),
-        connect_(this, control, &ColorPreview::SetColor)
+        connect_(this, control, &ColorPreview::SetColor),
+        damage_(this)
     {
         this->SetColor(control.Get());
     }
 
     void SetColor(const Color &color)
     {
-        this->SetBackgroundColour(ToWxColour(color));
-        this->Refresh();
+        auto colour = ToWxColour(color);
+
+        if (colour == this->GetBackgroundColour())
+        {
+            // Nothing to redraw.
+            return;
+        }
+
+        this->SetBackgroundColour(colour);
+        this->damage_.AddAll();
+        this->damage_.Refresh();
     }
 
 private:
     pex::MakeConnector<ColorPreview, ColorControl> connect_;
+    DamageTracker damage_;
 };
 
 
@@ -0,0 +1,655 @@
+#include "wxpex/color_kernels.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define WXPEX_COLOR_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace wxpex
+{
+
+
+namespace
+{
+
+
+// Pixels are converted through arrays of this many floats per channel, which
+// fit in L1 and divide into whole vectors.
+constexpr size_t blockSize = 64;
+
+
+float ToFloat(uint8_t channel)
+{
+    return static_cast<float>(channel) / 255.0f;
+}
+
+
+// NaN becomes 0, because std::max returns its first argument when the
+// comparison is false.
+uint8_t ToChannel(float value)
+{
+    return static_cast<uint8_t>(
+        std::round(std::min(std::max(0.0f, value), 1.0f) * 255.0f));
+}
+
+
+// One channel per array, so that four pixels load as one vector.
+struct Block
+{
+    alignas(16) float first[blockSize];
+    alignas(16) float second[blockSize];
+    alignas(16) float third[blockSize];
+};
+
+
+/**
+ ** The scalar and SSE2 conversions perform the same operations in the same
+ ** order, so they agree to the bit with each other and with tau.
+ **
+ ** The scalar conversions select between candidates instead of branching, so
+ ** that compilers can vectorize the loops over a block on targets without
+ ** SSE2, like NEON on ARM.
+ **
+ ** Where tau branches on the largest channel or the hue sector, these
+ ** compute every candidate and keep one. Divisors that could be zero are
+ ** raised to minimumDivisor. Channels are multiples of 1 / 255, so this only
+ ** changes divisors that are zero, where the numerators are zero too, and the
+ ** results are zero, as they should be.
+ **/
+constexpr float minimumDivisor = 1e-30f;
+
+
+#ifdef WXPEX_COLOR_KERNELS_SSE2
+
+
+__m128 Select(__m128 mask, __m128 value)
+{
+    return _mm_and_ps(mask, value);
+}
+
+
+__m128 Select(__m128i mask, __m128 value)
+{
+    return _mm_and_ps(_mm_castsi128_ps(mask), value);
+}
+
+
+void RgbToHsvVector(
+    const float *red,
+    const float *green,
+    const float *blue,
+    float *hue,
+    float *saturation,
+    float *value)
+{
+    auto r = _mm_load_ps(red);
+    auto g = _mm_load_ps(green);
+    auto b = _mm_load_ps(blue);
+
+    auto maximum = _mm_max_ps(r, _mm_max_ps(g, b));
+    auto minimum = _mm_min_ps(r, _mm_min_ps(g, b));
+    auto chroma = _mm_sub_ps(maximum, minimum);
+
+    auto safeChroma = _mm_max_ps(chroma, _mm_set1_ps(minimumDivisor));
+    auto safeMaximum = _mm_max_ps(maximum, _mm_set1_ps(minimumDivisor));
+
+    auto isRed = _mm_cmpeq_ps(maximum, r);
+    auto isGreen = _mm_andnot_ps(isRed, _mm_cmpeq_ps(maximum, g));
+    auto isRedOrGreen = _mm_or_ps(isRed, isGreen);
+
+    auto hueRed = _mm_div_ps(_mm_sub_ps(g, b), safeChroma);
+
+    auto hueGreen = _mm_add_ps(
+        _mm_div_ps(_mm_sub_ps(b, r), safeChroma),
+        _mm_set1_ps(2.0f));
+
+    auto hueBlue = _mm_add_ps(
+        _mm_div_ps(_mm_sub_ps(r, g), safeChroma),
+        _mm_set1_ps(4.0f));
+
+    auto h = _mm_or_ps(
+        Select(isRed, hueRed),
+        _mm_or_ps(
+            Select(isGreen, hueGreen),
+            _mm_andnot_ps(isRedOrGreen, hueBlue)));
+
+    h = _mm_mul_ps(h, _mm_set1_ps(60.0f));
+
+    h = _mm_add_ps(
+        h,
+        Select(_mm_cmplt_ps(h, _mm_setzero_ps()), _mm_set1_ps(360.0f)));
+
+    _mm_store_ps(hue, h);
+    _mm_store_ps(saturation, _mm_div_ps(chroma, safeMaximum));
+    _mm_store_ps(value, maximum);
+}
+
+
+void HsvToRgbVector(
+    const float *hue,
+    const float *saturation,
+    const float *value,
+    float *red,
+    float *green,
+    float *blue)
+{
+    auto v = _mm_load_ps(value);
+
+    auto h = _mm_div_ps(
+        _mm_min_ps(
+            _mm_max_ps(_mm_load_ps(hue), _mm_setzero_ps()),
+            _mm_set1_ps(360.0f)),
+        _mm_set1_ps(60.0f));
+
+    auto chroma = _mm_mul_ps(v, _mm_load_ps(saturation));
+
+    auto halfSector = _mm_sub_ps(
+        h,
+        _mm_mul_ps(
+            _mm_set1_ps(2.0f),
+            _mm_cvtepi32_ps(
+                _mm_cvttps_epi32(_mm_mul_ps(h, _mm_set1_ps(0.5f))))));
+
+    // Clearing the sign bit is std::abs.
+    auto distance = _mm_andnot_ps(
+        _mm_set1_ps(-0.0f),
+        _mm_sub_ps(halfSector, _mm_set1_ps(1.0f)));
+
+    auto x = _mm_mul_ps(chroma, _mm_sub_ps(_mm_set1_ps(1.0f), distance));
+    auto m = _mm_sub_ps(v, chroma);
+
+    auto sector = _mm_cvttps_epi32(h);
+
+    // A hue of 360 is the same as 0.
+    sector = _mm_sub_epi32(
+        sector,
+        _mm_and_si128(
+            _mm_cmpgt_epi32(sector, _mm_set1_epi32(5)),
+            _mm_set1_epi32(6)));
+
+    auto isSector = [sector](int first, int second) -> __m128i
+    {
+        return _mm_or_si128(
+            _mm_cmpeq_epi32(sector, _mm_set1_epi32(first)),
+            _mm_cmpeq_epi32(sector, _mm_set1_epi32(second)));
+    };
+
+    auto r = _mm_or_ps(
+        Select(isSector(0, 5), chroma),
+        Select(isSector(1, 4), x));
+
+    auto g = _mm_or_ps(
+        Select(isSector(1, 2), chroma),
+        Select(isSector(0, 3), x));
+
+    auto b = _mm_or_ps(
+        Select(isSector(3, 4), chroma),
+        Select(isSector(2, 5), x));
+
+    _mm_store_ps(red, _mm_add_ps(r, m));
+    _mm_store_ps(green, _mm_add_ps(g, m));
+    _mm_store_ps(blue, _mm_add_ps(b, m));
+}
+
+
+constexpr size_t vectorSize = 4;
+
+
+#else
+
+
+void RgbToHsvPixel(
+    float r,
+    float g,
+    float b,
+    float &hue,
+    float &saturation,
+    float &value)
+{
+    auto maximum = std::max(r, std::max(g, b));
+    auto minimum = std::min(r, std::min(g, b));
+    auto chroma = maximum - minimum;
+
+    auto safeChroma = std::max(chroma, minimumDivisor);
+    auto safeMaximum = std::max(maximum, minimumDivisor);
+
+    // Red wins ties, then green.
+    auto isRed = (maximum == r);
+    auto isGreen = !isRed && (maximum == g);
+
+    auto hueRed = (g - b) / safeChroma;
+    auto hueGreen = (b - r) / safeChroma + 2.0f;
+    auto hueBlue = (r - g) / safeChroma + 4.0f;
+
+    auto h = isRed ? hueRed : (isGreen ? hueGreen : hueBlue);
+    h *= 60.0f;
+
+    hue = h + ((h < 0.0f) ? 360.0f : 0.0f);
+    saturation = chroma / safeMaximum;
+    value = maximum;
+}
+
+
+void HsvToRgbPixel(
+    float hue,
+    float saturation,
+    float value,
+    float &red,
+    float &green,
+    float &blue)
+{
+    // Like _mm_max_ps, this returns 0 for a NaN hue.
+    auto h = std::min(std::max(0.0f, hue), 360.0f) / 60.0f;
+    auto chroma = value * saturation;
+
+    // h is not negative, so truncation is floor, and this is equal to
+    // std::fmod(h, 2.0f).
+    auto halfSector = h - 2.0f * static_cast<float>(static_cast<int>(h * 0.5f));
+    auto x = chroma * (1.0f - std::abs(halfSector - 1.0f));
+    auto m = value - chroma;
+
+    // A hue of 360 is the same as 0.
+    auto sector = static_cast<int>(h);
+    sector -= (sector > 5) ? 6 : 0;
+
+    auto isSector = [sector](int first, int second) -> bool
+    {
+        return sector == first || sector == second;
+    };
+
+    auto r = isSector(0, 5) ? chroma : (isSector(1, 4) ? x : 0.0f);
+    auto g = isSector(1, 2) ? chroma : (isSector(0, 3) ? x : 0.0f);
+    auto b = isSector(3, 4) ? chroma : (isSector(2, 5) ? x : 0.0f);
+
+    red = r + m;
+    green = g + m;
+    blue = b + m;
+}
+
+
+#endif // WXPEX_COLOR_KERNELS_SSE2
+
+
+struct RgbToHsvBlock
+{
+    void operator()(size_t count, const Block &rgb, Block &hsv) const
+    {
+#ifdef WXPEX_COLOR_KERNELS_SSE2
+        // Lanes past count hold values from an earlier block, or zeros, and
+        // their results are never stored.
+        for (size_t i = 0; i < count; i += vectorSize)
+        {
+            RgbToHsvVector(
+                rgb.first + i,
+                rgb.second + i,
+                rgb.third + i,
+                hsv.first + i,
+                hsv.second + i,
+                hsv.third + i);
+        }
+#else
+        for (size_t i = 0; i < count; ++i)
+        {
+            RgbToHsvPixel(
+                rgb.first[i],
+                rgb.second[i],
+                rgb.third[i],
+                hsv.first[i],
+                hsv.second[i],
+                hsv.third[i]);
+        }
+#endif
+    }
+};
+
+
+struct HsvToRgbBlock
+{
+    void operator()(size_t count, const Block &hsv, Block &rgb) const
+    {
+#ifdef WXPEX_COLOR_KERNELS_SSE2
+        for (size_t i = 0; i < count; i += vectorSize)
+        {
+            HsvToRgbVector(
+                hsv.first + i,
+                hsv.second + i,
+                hsv.third + i,
+                rgb.first + i,
+                rgb.second + i,
+                rgb.third + i);
+        }
+#else
+        for (size_t i = 0; i < count; ++i)
+        {
+            HsvToRgbPixel(
+                hsv.first[i],
+                hsv.second[i],
+                hsv.third[i],
+                rgb.first[i],
+                rgb.second[i],
+                rgb.third[i]);
+        }
+#endif
+    }
+};
+
+
+/**
+ ** Converts pixels begin to end, one block at a time.
+ **
+ ** load(index, first, second, third) reads the channels of one pixel as
+ ** floats, and store(index, first, second, third) writes the converted
+ ** pixel.
+ **/
+template<typename Load, typename Store, typename ConvertBlock>
+void ConvertBlocks(
+    size_t begin,
+    size_t end,
+    Load load,
+    Store store,
+    ConvertBlock convertBlock)
+{
+    Block source{};
+    Block target{};
+
+    for (size_t blockBegin = begin; blockBegin < end; blockBegin += blockSize)
+    {
+        auto count = std::min(blockSize, end - blockBegin);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            load(
+                blockBegin + i,
+                source.first[i],
+                source.second[i],
+                source.third[i]);
+        }
+
+        convertBlock(count, source, target);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            store(
+                blockBegin + i,
+                target.first[i],
+                target.second[i],
+                target.third[i]);
+        }
+    }
+}
+
+
+/**
+ ** Calls convert(begin, end) for contiguous parts of count pixels, on as
+ ** many threads as settings allows. The calling thread converts the first
+ ** part.
+ **/
+template<typename Convert>
+void Divide(size_t count, const ConversionSettings &settings, Convert convert)
+{
+    auto threadCount = std::min(
+        static_cast<size_t>(std::max(1u, settings.threadCount)),
+        count / std::max<size_t>(1, settings.minimumPerThread));
+
+    if (threadCount <= 1)
+    {
+        convert(size_t(0), count);
+
+        return;
+    }
+
+    auto blockCount = (count + blockSize - 1) / blockSize;
+    auto part = ((blockCount + threadCount - 1) / threadCount) * blockSize;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+
+    for (size_t begin = part; begin < count; begin += part)
+    {
+        workers.emplace_back(convert, begin, std::min(count, begin + part));
+    }
+
+    convert(size_t(0), std::min(count, part));
+
+    for (auto &worker: workers)
+    {
+        worker.join();
+    }
+}
+
+
+template<typename Load, typename Store>
+void ToHsv(
+    size_t count,
+    const ConversionSettings &settings,
+    Load load,
+    Store store)
+{
+    Divide(
+        count,
+        settings,
+        [&](size_t begin, size_t end)
+        {
+            ConvertBlocks(begin, end, load, store, RgbToHsvBlock{});
+        });
+}
+
+
+template<typename Load, typename Store>
+void ToRgb(
+    size_t count,
+    const ConversionSettings &settings,
+    Load load,
+    Store store)
+{
+    Divide(
+        count,
+        settings,
+        [&](size_t begin, size_t end)
+        {
+            ConvertBlocks(begin, end, load, store, HsvToRgbBlock{});
+        });
+}
+
+
+} // end anonymous namespace
+
+
+void RgbToHsv(
+    const Rgb8 *source,
+    HsvFloat *target,
+    size_t count,
+    const ConversionSettings &settings)
+{
+    ToHsv(
+        count,
+        settings,
+        [source](size_t index, float &red, float &green, float &blue)
+        {
+            red = ToFloat(source[index].red);
+            green = ToFloat(source[index].green);
+            blue = ToFloat(source[index].blue);
+        },
+        [target](size_t index, float hue, float saturation, float value)
+        {
+            target[index].hue = hue;
+            target[index].saturation = saturation;
+            target[index].value = value;
+        });
+}
+
+
+void HsvToRgb(
+    const HsvFloat *source,
+    Rgb8 *target,
+    size_t count,
+    const ConversionSettings &settings)
+{
+    ToRgb(
+        count,
+        settings,
+        [source](size_t index, float &hue, float &saturation, float &value)
+        {
+            hue = source[index].hue;
+            saturation = source[index].saturation;
+            value = source[index].value;
+        },
+        [target](size_t index, float red, float green, float blue)
+        {
+            target[index].red = ToChannel(red);
+            target[index].green = ToChannel(green);
+            target[index].blue = ToChannel(blue);
+        });
+}
+
+
+void RgbaToHsva(
+    const Rgba8 *source,
+    HsvaFloat *target,
+    size_t count,
+    const ConversionSettings &settings)
+{
+    ToHsv(
+        count,
+        settings,
+        [source](size_t index, float &red, float &green, float &blue)
+        {
+            red = ToFloat(source[index].red);
+            green = ToFloat(source[index].green);
+            blue = ToFloat(source[index].blue);
+        },
+        [source, target](
+            size_t index,
+            float hue,
+            float saturation,
+            float value)
+        {
+            target[index].hue = hue;
+            target[index].saturation = saturation;
+            target[index].value = value;
+            target[index].alpha = ToFloat(source[index].alpha);
+        });
+}
+
+
+void HsvaToRgba(
+    const HsvaFloat *source,
+    Rgba8 *target,
+    size_t count,
+    const ConversionSettings &settings)
+{
+    ToRgb(
+        count,
+        settings,
+        [source](size_t index, float &hue, float &saturation, float &value)
+        {
+            hue = source[index].hue;
+            saturation = source[index].saturation;
+            value = source[index].value;
+        },
+        [source, target](size_t index, float red, float green, float blue)
+        {
+            target[index].red = ToChannel(red);
+            target[index].green = ToChannel(green);
+            target[index].blue = ToChannel(blue);
+            target[index].alpha = ToChannel(source[index].alpha);
+        });
+}
+
+
+void PackedRgbToHsv(
+    const uint8_t *source,
+    HsvFloat *target,
+    size_t count,
+    const ConversionSettings &settings)
+{
+    ToHsv(
+        count,
+        settings,
+        [source](size_t index, float &red, float &green, float &blue)
+        {
+            auto pixel = source + 3 * index;
+            red = ToFloat(pixel[0]);
+            green = ToFloat(pixel[1]);
+            blue = ToFloat(pixel[2]);
+        },
+        [target](size_t index, float hue, float saturation, float value)
+        {
+            target[index].hue = hue;
+            target[index].saturation = saturation;
+            target[index].value = value;
+        });
+}
+
+
+void HsvToPackedRgb(
+    const HsvFloat *source,
+    uint8_t *target,
+    size_t count,
+    const ConversionSettings &settings)
+{
+    ToRgb(
+        count,
+        settings,
+        [source](size_t index, float &hue, float &saturation, float &value)
+        {
+            hue = source[index].hue;
+            saturation = source[index].saturation;
+            value = source[index].value;
+        },
+        [target](size_t index, float red, float green, float blue)
+        {
+            auto pixel = target + 3 * index;
+            pixel[0] = ToChannel(red);
+            pixel[1] = ToChannel(green);
+            pixel[2] = ToChannel(blue);
+        });
+}
+
+
+std::vector<HsvFloat> ImageToHsv(
+    const wxImage &image,
+    const ConversionSettings &settings)
+{
+    if (!image.IsOk())
+    {
+        throw std::invalid_argument("Invalid image");
+    }
+
+    auto count = static_cast<size_t>(image.GetWidth())
+        * static_cast<size_t>(image.GetHeight());
+
+    std::vector<HsvFloat> result(count);
+    PackedRgbToHsv(image.GetData(), result.data(), count, settings);
+
+    return result;
+}
+
+
+void HsvToImage(
+    const std::vector<HsvFloat> &colors,
+    wxImage &image,
+    const ConversionSettings &settings)
+{
+    if (!image.IsOk())
+    {
+        throw std::invalid_argument("Invalid image");
+    }
+
+    auto count = static_cast<size_t>(image.GetWidth())
+        * static_cast<size_t>(image.GetHeight());
+
+    if (colors.size() != count)
+    {
+        throw std::invalid_argument("Expected one color for each pixel");
+    }
+
+    HsvToPackedRgb(colors.data(), image.GetData(), count, settings);
+}
+
+
+} // end namespace wxpex
@@ -0,0 +1,140 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <tau/color.h>
+
+#include "wxpex/ignores.h"
+
+WXSHIM_PUSH_IGNORES
+#include <wx/image.h>
+WXSHIM_POP_IGNORES
+
+
+/**
+ ** Bulk conversions between 8-bit RGB(A) and floating point HSV(A), for
+ ** rendering color fields and recoloring images.
+ **
+ ** Each pixel gives the same result as tau::RgbToHsv<float> and
+ ** tau::HsvToRgb<uint8_t, float>. Pixels are converted in blocks, four at a
+ ** time with SSE2 on x86. Other targets use branch-free scalar code, and
+ ** only run as vectors where the compiler vectorizes it. Large buffers are
+ ** divided between threads.
+ **
+ ** Hue is in degrees, from 0 to 360. Hues outside of that are clamped, and
+ ** NaN is treated as 0. Saturation, value, and alpha are from 0 to 1.
+ **/
+
+
+namespace wxpex
+{
+
+
+class ConversionSettings
+{
+public:
+    // Smaller buffers are not worth the cost of starting a thread.
+    static constexpr size_t defaultMinimumPerThread = 1 << 16;
+
+    ConversionSettings()
+        :
+        threadCount(std::max(1u, std::thread::hardware_concurrency())),
+        minimumPerThread(defaultMinimumPerThread)
+    {
+
+    }
+
+    // All setting functions return a reference to this instance so they can be
+    // chained.
+    //
+    // settings.ThreadCount(4).MinimumPerThread(1024);
+
+    // Defaults to the number of hardware threads.
+    ConversionSettings & ThreadCount(unsigned value)
+    {
+        this->threadCount = value;
+        return *this;
+    }
+
+    // The fewest pixels converted by each thread.
+    ConversionSettings & MinimumPerThread(size_t value)
+    {
+        this->minimumPerThread = value;
+        return *this;
+    }
+
+    unsigned threadCount;
+    size_t minimumPerThread;
+};
+
+
+using Rgb8 = tau::Rgb<uint8_t>;
+using Rgba8 = tau::Rgba<uint8_t>;
+using HsvFloat = tau::Hsv<float>;
+using HsvaFloat = tau::Hsva<float>;
+
+
+void RgbToHsv(
+    const Rgb8 *source,
+    HsvFloat *target,
+    size_t count,
+    const ConversionSettings &settings = ConversionSettings());
+
+
+void HsvToRgb(
+    const HsvFloat *source,
+    Rgb8 *target,
+    size_t count,
+    const ConversionSettings &settings = ConversionSettings());
+
+
+void RgbaToHsva(
+    const Rgba8 *source,
+    HsvaFloat *target,
+    size_t count,
+    const ConversionSettings &settings = ConversionSettings());
+
+
+void HsvaToRgba(
+    const HsvaFloat *source,
+    Rgba8 *target,
+    size_t count,
+    const ConversionSettings &settings = ConversionSettings());
+
+
+// Packed RGB bytes, as returned by wxImage::GetData.
+void PackedRgbToHsv(
+    const uint8_t *source,
+    HsvFloat *target,
+    size_t count,
+    const ConversionSettings &settings = ConversionSettings());
+
+
+void HsvToPackedRgb(
+    const HsvFloat *source,
+    uint8_t *target,
+    size_t count,
+    const ConversionSettings &settings = ConversionSettings());
+
+
+// One HSV color per pixel, in row-major order. Alpha is ignored.
+std::vector<HsvFloat> ImageToHsv(
+    const wxImage &image,
+    const ConversionSettings &settings = ConversionSettings());
+
+
+/**
+ ** Writes the RGB data of image, which must have one pixel for each color.
+ ** Alpha is left unchanged.
+ **/
+void HsvToImage(
+    const std::vector<HsvFloat> &colors,
+    wxImage &image,
+    const ConversionSettings &settings = ConversionSettings());
+
+
+} // end namespace wxpex
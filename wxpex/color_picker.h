@@ -5,6 +5,7 @@
 #include "wxpex/color.h"
 #include "wxpex/slider.h"
 #include "wxpex/knob.h"
+#include "wxpex/color_wheel.h"
 
 
 namespace wxpex
@@ -190,8 +191,10 @@ public:
         knobs_(this->GetPanel(), control)
     {
         auto colorPreview = new ColorPreview(this->GetPanel(), control);
+        auto wheel = new ColorWheel<Control>(this->GetPanel(), control);
         auto knobLayout = this->knobs_.MakeKnobs();
         auto sizer = std::make_unique<wxBoxSizer>(wxHORIZONTAL);
+        sizer->Add(wheel, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
         sizer->Add(knobLayout.release(), 1, wxRight, 5);
         auto vertical = std::make_unique<wxBoxSizer>(wxVERTICAL);
 
@@ -0,0 +1,350 @@
+#include "wxpex/color_wheel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "wxpex/point.h"
+#include "wxpex/size.h"
+#include "wxpex/resource_cache.h"
+
+
+namespace wxpex
+{
+
+
+namespace
+{
+
+
+constexpr double pi = 3.14159265358979323846;
+
+
+// Room for the marker when it is on the edge of the wheel.
+double GetMargin(const ColorWheelSettings &settings)
+{
+    return settings.markerRadius + 2.0;
+}
+
+
+} // end anonymous namespace
+
+
+wxImage MakeColorWheelImage(int diameter, const ConversionSettings &settings)
+{
+    if (diameter < 1)
+    {
+        throw std::invalid_argument("diameter must be positive");
+    }
+
+    auto radius = static_cast<double>(diameter) / 2.0;
+    auto pixelCount = static_cast<size_t>(diameter * diameter);
+
+    std::vector<HsvFloat> colors;
+    colors.reserve(pixelCount);
+
+    wxImage image(diameter, diameter);
+    image.InitAlpha();
+    auto alpha = image.GetAlpha();
+
+    for (int y = 0; y < diameter; ++y)
+    {
+        for (int x = 0; x < diameter; ++x)
+        {
+            // Sample the center of each pixel.
+            auto point = tau::Point2d<double>(x + 0.5, y + 0.5);
+
+            auto [hue, saturation] = GetColorWheelHueSaturation(
+                tau::Point2d<double>(radius, radius),
+                radius,
+                point);
+
+            colors.push_back(
+                {{
+                    static_cast<float>(hue),
+                    static_cast<float>(saturation),
+                    1.0f}});
+
+            // Fade out over the last pixel, so the edge is antialiased.
+            auto distance = std::hypot(point.x - radius, point.y - radius);
+            auto coverage = std::clamp(radius - distance + 0.5, 0.0, 1.0);
+
+            *alpha++ = static_cast<unsigned char>(
+                std::round(coverage * 255.0));
+        }
+    }
+
+    HsvToImage(colors, image, settings);
+
+    return image;
+}
+
+
+HueSaturation GetColorWheelHueSaturation(
+    const tau::Point2d<double> &center,
+    double radius,
+    const tau::Point2d<double> &point)
+{
+    auto x = point.x - center.x;
+
+    // Screen coordinates increase downward, and hue increases
+    // counterclockwise from the positive x axis.
+    auto y = center.y - point.y;
+
+    auto hue = std::atan2(y, x) * 180.0 / pi;
+
+    if (hue < 0.0)
+    {
+        hue += 360.0;
+    }
+
+    auto saturation = (radius > 0.0)
+        ? std::min(std::hypot(x, y) / radius, 1.0)
+        : 0.0;
+
+    return {hue, saturation};
+}
+
+
+tau::Point2d<double> GetColorWheelPoint(
+    const tau::Point2d<double> &center,
+    double radius,
+    const HueSaturation &hueSaturation)
+{
+    auto angle = hueSaturation.hue * pi / 180.0;
+    auto distance = hueSaturation.saturation * radius;
+
+    return tau::Point2d<double>(
+        center.x + distance * std::cos(angle),
+        center.y - distance * std::sin(angle));
+}
+
+
+ColorWheelBase::ColorWheelBase(
+    wxWindow *parent,
+    const ColorWheelSettings &settings)
+    :
+    Canvas(parent, wxID_ANY),
+    settings_(settings),
+    hueSaturation_{0.0, 0.0},
+    value_(1.0),
+    hasCapturedMouse_(false),
+    wheel_(),
+    wheelRenderer_(nullptr),
+    wheelPixels_(0)
+{
+    this->Bind(wxEVT_LEFT_DOWN, &ColorWheelBase::OnMouseEvents_, this);
+    this->Bind(wxEVT_MOTION, &ColorWheelBase::OnMouseEvents_, this);
+    this->Bind(wxEVT_LEFT_UP, &ColorWheelBase::OnMouseEvents_, this);
+
+    this->Bind(
+        wxEVT_MOUSE_CAPTURE_LOST,
+        &ColorWheelBase::OnMouseCaptureLost_,
+        this);
+}
+
+
+wxSize ColorWheelBase::DoGetBestClientSize() const
+{
+    auto side = this->settings_.diameter
+        + 2 * static_cast<int>(std::ceil(GetMargin(this->settings_)));
+
+    return wxSize(side, side);
+}
+
+
+void ColorWheelBase::SetHueSaturation_(const HueSaturation &hueSaturation)
+{
+    if (
+        hueSaturation.hue == this->hueSaturation_.hue
+        && hueSaturation.saturation == this->hueSaturation_.saturation)
+    {
+        return;
+    }
+
+    // Only the marker moves. Redraw where it was, and where it will be.
+    this->RefreshRect(this->GetMarkerRect_(), false);
+    this->hueSaturation_ = hueSaturation;
+    this->RefreshRect(this->GetMarkerRect_(), false);
+}
+
+
+void ColorWheelBase::SetValue_(double value)
+{
+    if (value == this->value_)
+    {
+        return;
+    }
+
+    this->value_ = value;
+    this->Refresh(false);
+}
+
+
+void ColorWheelBase::DrawCanvas_(GraphicsContext &context, const wxRect &)
+{
+    auto radius = this->GetRadius_();
+
+    if (radius <= 0.0)
+    {
+        return;
+    }
+
+    auto center = this->GetCenter_();
+    auto left = center.x - radius;
+    auto top = center.y - radius;
+    auto diameter = 2.0 * radius;
+
+    context->DrawBitmap(
+        this->GetWheel_(context),
+        left,
+        top,
+        diameter,
+        diameter);
+
+    auto &resources = GraphicsResourceCache::Get(context);
+
+    if (this->value_ < 1.0)
+    {
+        // Scaling value scales each channel, which is the same as blending
+        // with black.
+        auto darkness = std::clamp(1.0 - this->value_, 0.0, 1.0);
+
+        context->SetPen(wxNullPen);
+
+        context->SetBrush(
+            resources.GetBrush(
+                wxColour(
+                    0,
+                    0,
+                    0,
+                    static_cast<unsigned char>(std::round(darkness * 255.0)))));
+
+        context->DrawEllipse(left, top, diameter, diameter);
+    }
+
+    auto marker = GetColorWheelPoint(center, radius, this->hueSaturation_);
+    auto markerRadius = this->settings_.markerRadius;
+    auto markerDiameter = 2.0 * markerRadius;
+
+    // A white ring around a black one shows on any color.
+    context->SetBrush(wxNullBrush);
+    context->SetPen(resources.GetPen(*wxWHITE, 3.0));
+
+    context->DrawEllipse(
+        marker.x - markerRadius,
+        marker.y - markerRadius,
+        markerDiameter,
+        markerDiameter);
+
+    context->SetPen(resources.GetPen(*wxBLACK, 1.0));
+
+    context->DrawEllipse(
+        marker.x - markerRadius,
+        marker.y - markerRadius,
+        markerDiameter,
+        markerDiameter);
+}
+
+
+void ColorWheelBase::OnMouseEvents_(wxMouseEvent &mouseEvent)
+{
+    if (mouseEvent.LeftDown())
+    {
+        if (!this->hasCapturedMouse_)
+        {
+            this->CaptureMouse();
+            this->hasCapturedMouse_ = true;
+        }
+    }
+    else if (mouseEvent.LeftUp())
+    {
+        if (this->hasCapturedMouse_)
+        {
+            this->ReleaseMouse();
+            this->hasCapturedMouse_ = false;
+        }
+
+        return;
+    }
+
+    if (!this->hasCapturedMouse_ || !mouseEvent.LeftIsDown())
+    {
+        return;
+    }
+
+    this->OnPick_(
+        GetColorWheelHueSaturation(
+            this->GetCenter_(),
+            this->GetRadius_(),
+            ToPoint<double>(mouseEvent.GetPosition())));
+}
+
+
+void ColorWheelBase::OnMouseCaptureLost_(wxMouseCaptureLostEvent &)
+{
+    this->hasCapturedMouse_ = false;
+}
+
+
+tau::Point2d<double> ColorWheelBase::GetCenter_() const
+{
+    return (ToSize<double>(this->GetClientSize()) / 2).ToPoint2d();
+}
+
+
+double ColorWheelBase::GetRadius_() const
+{
+    auto clientSize = this->GetClientSize();
+
+    auto side = static_cast<double>(
+        std::min(clientSize.GetWidth(), clientSize.GetHeight()));
+
+    return std::max(0.0, side / 2.0 - GetMargin(this->settings_));
+}
+
+
+wxRect ColorWheelBase::GetMarkerRect_() const
+{
+    auto marker = GetColorWheelPoint(
+        this->GetCenter_(),
+        this->GetRadius_(),
+        this->hueSaturation_);
+
+    // Half the outer pen width, and one pixel for antialiasing.
+    auto halfSide = this->settings_.markerRadius + 2.5;
+
+    auto left = static_cast<int>(std::floor(marker.x - halfSide));
+    auto top = static_cast<int>(std::floor(marker.y - halfSide));
+    auto right = static_cast<int>(std::ceil(marker.x + halfSide));
+    auto bottom = static_cast<int>(std::ceil(marker.y + halfSide));
+
+    return wxRect(left, top, right - left, bottom - top);
+}
+
+
+const wxGraphicsBitmap & ColorWheelBase::GetWheel_(GraphicsContext &context)
+{
+    auto pixels = static_cast<int>(
+        std::ceil(2.0 * this->GetRadius_() * this->GetContentScaleFactor()));
+
+    pixels = std::max(pixels, 1);
+    auto renderer = context->GetRenderer();
+
+    if (
+        pixels != this->wheelPixels_
+        || renderer != this->wheelRenderer_
+        || this->wheel_.IsNull())
+    {
+        this->wheel_ =
+            context->CreateBitmapFromImage(MakeColorWheelImage(pixels));
+
+        this->wheelRenderer_ = renderer;
+        this->wheelPixels_ = pixels;
+    }
+
+    return this->wheel_;
+}
+
+
+} // end namespace wxpex
@@ -0,0 +1,188 @@
+#pragma once
+
+
+#include <tau/vector2d.h>
+#include <pex/endpoint.h>
+
+#include "wxpex/ignores.h"
+
+WXSHIM_PUSH_IGNORES
+#include <wx/image.h>
+WXSHIM_POP_IGNORES
+
+#include "wxpex/canvas.h"
+#include "wxpex/color_kernels.h"
+
+
+namespace wxpex
+{
+
+
+class ColorWheelSettings
+{
+public:
+    static constexpr int defaultDiameter = 160;
+    static constexpr double defaultMarkerRadius = 5.0;
+
+    ColorWheelSettings()
+        :
+        diameter(defaultDiameter),
+        markerRadius(defaultMarkerRadius)
+    {
+
+    }
+
+    // All setting functions return a reference to this instance so they can be
+    // chained.
+    //
+    // settings.Diameter(240).MarkerRadius(6.0);
+
+    // The preferred diameter. The wheel fills the smaller side of the window.
+    ColorWheelSettings & Diameter(int value)
+    {
+        this->diameter = value;
+        return *this;
+    }
+
+    ColorWheelSettings & MarkerRadius(double value)
+    {
+        this->markerRadius = value;
+        return *this;
+    }
+
+    int diameter;
+    double markerRadius;
+};
+
+
+/**
+ ** Renders a disk of diameter pixels, with hue as the angle, counterclockwise
+ ** from red on the right, and saturation increasing from the center. Value is
+ ** 1 everywhere. Pixels outside of the disk are transparent.
+ **/
+wxImage MakeColorWheelImage(
+    int diameter,
+    const ConversionSettings &settings = ConversionSettings());
+
+
+struct HueSaturation
+{
+    double hue;
+    double saturation;
+};
+
+
+/**
+ ** The hue and saturation at point on a wheel of radius centered on center.
+ ** Points outside of the wheel are moved to its edge.
+ **/
+HueSaturation GetColorWheelHueSaturation(
+    const tau::Point2d<double> &center,
+    double radius,
+    const tau::Point2d<double> &point);
+
+
+// The inverse of GetColorWheelHueSaturation.
+tau::Point2d<double> GetColorWheelPoint(
+    const tau::Point2d<double> &center,
+    double radius,
+    const HueSaturation &hueSaturation);
+
+
+/**
+ ** The window part of ColorWheel, independent of the color control.
+ **
+ ** The wheel image is rendered once for each size and kept in a graphics
+ ** bitmap, so that repaints draw it without converting it again.
+ ** Moving the marker only redraws the areas it leaves and enters, and a
+ ** change in value darkens the cached wheel with a translucent overlay
+ ** instead of rendering it again.
+ **/
+class ColorWheelBase: public Canvas
+{
+public:
+    ColorWheelBase(wxWindow *parent, const ColorWheelSettings &settings);
+
+    wxSize DoGetBestClientSize() const override;
+
+protected:
+    void SetHueSaturation_(const HueSaturation &hueSaturation);
+
+    void SetValue_(double value);
+
+    // Called while the user drags the marker.
+    virtual void OnPick_(const HueSaturation &hueSaturation) = 0;
+
+private:
+    void DrawCanvas_(GraphicsContext &context, const wxRect &) override;
+
+    void OnMouseEvents_(wxMouseEvent &mouseEvent);
+
+    void OnMouseCaptureLost_(wxMouseCaptureLostEvent &);
+
+    tau::Point2d<double> GetCenter_() const;
+
+    double GetRadius_() const;
+
+    wxRect GetMarkerRect_() const;
+
+    // Renders the wheel again if the size, the scale factor, or the renderer
+    // of context has changed.
+    const wxGraphicsBitmap & GetWheel_(GraphicsContext &context);
+
+    ColorWheelSettings settings_;
+    HueSaturation hueSaturation_;
+    double value_;
+    bool hasCapturedMouse_;
+    wxGraphicsBitmap wheel_;
+    wxGraphicsRenderer *wheelRenderer_;
+    int wheelPixels_;
+};
+
+
+/**
+ ** A hue and saturation picker for HsvControl or HsvaControl.
+ **/
+template<typename Control>
+class ColorWheel: public ColorWheelBase
+{
+public:
+    static constexpr auto observerName = "wxpex::ColorWheel";
+
+    using Color = typename Control::Type;
+
+    ColorWheel(
+        wxWindow *parent,
+        Control control,
+        const ColorWheelSettings &settings = ColorWheelSettings())
+        :
+        ColorWheelBase(parent, settings),
+        control_(control),
+        connect_(this, control, &ColorWheel::OnColor_)
+    {
+        this->OnColor_(control.Get());
+    }
+
+private:
+    void OnColor_(const Color &color)
+    {
+        this->SetValue_(color.value);
+        this->SetHueSaturation_({color.hue, color.saturation});
+    }
+
+    void OnPick_(const HueSaturation &hueSaturation) override
+    {
+        auto color = this->control_.Get();
+        color.hue = hueSaturation.hue;
+        color.saturation = hueSaturation.saturation;
+
+        // The connection moves the marker.
+        this->control_.Set(color);
+    }
+
+    Control control_;
+    pex::MakeConnector<ColorWheel, Control> connect_;
+};
+
+
+} // end namespace wxpex
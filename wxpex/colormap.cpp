@@ -0,0 +1,152 @@
+#include "wxpex/colormap.h"
+
+#include <cmath>
+#include <thread>
+
+
+namespace wxpex
+{
+
+
+Colormap::Colormap(const std::vector<Rgb> &colors, size_t size)
+    :
+    table_()
+{
+    if (colors.empty())
+    {
+        throw std::invalid_argument("Colormap requires at least one color");
+    }
+
+    if (size < 2)
+    {
+        throw std::invalid_argument("Colormap requires at least 2 entries");
+    }
+
+    this->table_.reserve(size * 3);
+
+    auto lastColor = static_cast<double>(colors.size() - 1);
+    auto lastEntry = static_cast<double>(size - 1);
+
+    for (size_t entry = 0; entry < size; ++entry)
+    {
+        // The position of this entry between the colors.
+        auto position = static_cast<double>(entry) * lastColor / lastEntry;
+        auto first = static_cast<size_t>(position);
+        auto second = std::min(first + 1, colors.size() - 1);
+        auto fraction = position - static_cast<double>(first);
+
+        auto interpolate = [fraction](uint8_t from, uint8_t to)
+        {
+            return static_cast<unsigned char>(
+                std::round(
+                    static_cast<double>(from)
+                    + fraction * (static_cast<double>(to) - from)));
+        };
+
+        this->table_.push_back(
+            interpolate(colors[first].red, colors[second].red));
+
+        this->table_.push_back(
+            interpolate(colors[first].green, colors[second].green));
+
+        this->table_.push_back(
+            interpolate(colors[first].blue, colors[second].blue));
+    }
+}
+
+
+Colormap Colormap::Gray(size_t size)
+{
+    return Colormap({{{0, 0, 0}}, {{255, 255, 255}}}, size);
+}
+
+
+Colormap Colormap::Rainbow(size_t size)
+{
+    std::vector<HsvFloat> hues;
+
+    // Every 10 degrees is close enough for linear interpolation.
+    for (int hue = 240; hue >= 0; hue -= 10)
+    {
+        hues.push_back({{static_cast<float>(hue), 1.0f, 1.0f}});
+    }
+
+    std::vector<Rgb> colors(hues.size());
+    HsvToRgb(hues.data(), colors.data(), hues.size());
+
+    return Colormap(colors, size);
+}
+
+
+size_t Colormap::GetSize() const
+{
+    return this->table_.size() / 3;
+}
+
+
+Colormap::Rgb Colormap::GetColor(size_t index) const
+{
+    auto color = &this->table_.at(index * 3);
+
+    return {{color[0], color[1], color[2]}};
+}
+
+
+const std::vector<unsigned char> & Colormap::GetTable() const
+{
+    return this->table_;
+}
+
+
+namespace detail
+{
+
+
+void DivideRows(
+    int height,
+    int width,
+    const ConversionSettings &settings,
+    const std::function<void(int begin, int end)> &mapRows)
+{
+    auto pixelCount = static_cast<size_t>(height) * static_cast<size_t>(width);
+
+    auto threadCount = std::min(
+        {
+            static_cast<size_t>(std::max(1u, settings.threadCount)),
+            pixelCount / std::max<size_t>(1, settings.minimumPerThread),
+            static_cast<size_t>(height)});
+
+    if (threadCount <= 1)
+    {
+        mapRows(0, height);
+
+        return;
+    }
+
+    auto rowsPerThread =
+        (static_cast<size_t>(height) + threadCount - 1) / threadCount;
+
+    auto part = static_cast<int>(rowsPerThread);
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+
+    for (int begin = part; begin < height; begin += part)
+    {
+        workers.emplace_back(mapRows, begin, std::min(height, begin + part));
+    }
+
+    // The calling thread maps the first rows.
+    mapRows(0, std::min(height, part));
+
+    for (auto &worker: workers)
+    {
+        worker.join();
+    }
+}
+
+
+} // end namespace detail
+
+
+} // end namespace wxpex
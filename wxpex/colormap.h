@@ -0,0 +1,428 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <Eigen/Dense>
+#include <tau/color.h>
+#include <pex/endpoint.h>
+
+#include "wxpex/ignores.h"
+
+WXSHIM_PUSH_IGNORES
+#include <wx/image.h>
+WXSHIM_POP_IGNORES
+
+#include "wxpex/color_kernels.h"
+#include "wxpex/frame_slot.h"
+
+
+namespace wxpex
+{
+
+
+/**
+ ** A lookup table of colors for rendering scalar values.
+ **
+ ** Entries are stored as packed RGB bytes, so mapping a value copies three
+ ** bytes from the table.
+ **/
+class Colormap
+{
+public:
+    using Rgb = tau::Rgb<uint8_t>;
+
+    static constexpr size_t defaultSize = 256;
+
+    /**
+     ** Interpolates linearly between colors, which are evenly spaced from
+     ** the first entry to the last.
+     **
+     ** @param size The number of entries, at least 2. Use 4096 for smooth
+     ** gradients over deep data, like 12 or 16 bit images.
+     **/
+    Colormap(const std::vector<Rgb> &colors, size_t size = defaultSize);
+
+    // From black to white.
+    static Colormap Gray(size_t size = defaultSize);
+
+    // Hue from blue to red, at full saturation and value.
+    static Colormap Rainbow(size_t size = defaultSize);
+
+    size_t GetSize() const;
+
+    Rgb GetColor(size_t index) const;
+
+    // GetSize() * 3 bytes.
+    const std::vector<unsigned char> & GetTable() const;
+
+private:
+    std::vector<unsigned char> table_;
+};
+
+
+/**
+ ** A two-dimensional view of scalars that does not own them.
+ **
+ ** Strides are in elements, so a row-major buffer has a columnStride of 1
+ ** and a rowStride of width.
+ **/
+template<typename T>
+struct ScalarField
+{
+    const T *data = nullptr;
+    int width = 0;
+    int height = 0;
+    ptrdiff_t columnStride = 1;
+    ptrdiff_t rowStride = 0;
+
+    static ScalarField RowMajor(const T *data, int width, int height)
+    {
+        return {data, width, height, 1, width};
+    }
+
+    const T * GetRow(int y) const
+    {
+        return this->data + y * this->rowStride;
+    }
+
+    bool IsEmpty() const
+    {
+        return this->width <= 0 || this->height <= 0;
+    }
+};
+
+
+/**
+ ** Views an Eigen matrix or array with direct access, like a Matrix, Array,
+ ** Map, or Block, with rows as image rows.
+ **
+ ** The view is only valid while the storage of array is unchanged.
+ **/
+template<typename Derived>
+ScalarField<typename Derived::Scalar> MakeScalarField(
+    const Eigen::DenseBase<Derived> &array)
+{
+    auto &derived = array.derived();
+
+    return {
+        derived.data(),
+        static_cast<int>(derived.cols()),
+        static_cast<int>(derived.rows()),
+        static_cast<ptrdiff_t>(derived.colStride()),
+        static_cast<ptrdiff_t>(derived.rowStride())};
+}
+
+
+namespace detail
+{
+
+
+/**
+ ** Calls mapRows(begin, end) for contiguous rows, on as many threads as
+ ** settings allows.
+ **/
+void DivideRows(
+    int height,
+    int width,
+    const ConversionSettings &settings,
+    const std::function<void(int begin, int end)> &mapRows);
+
+
+// Float is exact enough for every type except double.
+template<typename T>
+using MapFloat = std::conditional_t<std::is_same_v<T, double>, double, float>;
+
+
+template<typename T>
+void MapRow(
+    const T *row,
+    ptrdiff_t columnStride,
+    int width,
+    MapFloat<T> low,
+    MapFloat<T> scale,
+    MapFloat<T> lastIndex,
+    const unsigned char *table,
+    unsigned char *rgb)
+{
+    using Float = MapFloat<T>;
+
+    // Indices are computed a block at a time, in a loop without memory
+    // dependencies that the compiler vectorizes, then the colors are copied.
+    constexpr int blockSize = 256;
+    int32_t indices[blockSize];
+
+    for (int begin = 0; begin < width; begin += blockSize)
+    {
+        auto count = std::min(blockSize, width - begin);
+        auto values = row + begin * columnStride;
+
+        for (int i = 0; i < count; ++i)
+        {
+            auto position =
+                (static_cast<Float>(values[i * columnStride]) - low) * scale;
+
+            // NaN fails both comparisons, and gets the first color.
+            position = (position > Float(0)) ? position : Float(0);
+            position = (position < lastIndex) ? position : lastIndex;
+
+            indices[i] = static_cast<int32_t>(position + Float(0.5));
+        }
+
+        auto pixels = rgb + begin * 3;
+
+        for (int i = 0; i < count; ++i)
+        {
+            auto color = table + indices[i] * 3;
+            pixels[i * 3] = color[0];
+            pixels[i * 3 + 1] = color[1];
+            pixels[i * 3 + 2] = color[2];
+        }
+    }
+}
+
+
+} // end namespace detail
+
+
+/**
+ ** Writes the color of each value of field into rgb, as packed rows of
+ ** field.width * 3 bytes.
+ **
+ ** low gets the first color of the colormap, and high gets the last. Values
+ ** outside of the range get the nearest end, and an empty range maps every
+ ** value to the first color.
+ **/
+template<typename T>
+void MapColors(
+    const Colormap &colormap,
+    const ScalarField<T> &field,
+    double low,
+    double high,
+    unsigned char *rgb,
+    const ConversionSettings &settings = ConversionSettings())
+{
+    using Float = detail::MapFloat<T>;
+
+    if (field.IsEmpty())
+    {
+        return;
+    }
+
+    auto lastIndex = static_cast<double>(colormap.GetSize() - 1);
+    auto scale = (high > low) ? lastIndex / (high - low) : 0.0;
+    auto table = colormap.GetTable().data();
+    auto width = field.width;
+
+    detail::DivideRows(
+        field.height,
+        width,
+        settings,
+        [&](int begin, int end) -> void
+        {
+            for (int y = begin; y < end; ++y)
+            {
+                detail::MapRow(
+                    field.GetRow(y),
+                    field.columnStride,
+                    width,
+                    static_cast<Float>(low),
+                    static_cast<Float>(scale),
+                    static_cast<Float>(lastIndex),
+                    table,
+                    rgb + static_cast<ptrdiff_t>(y) * width * 3);
+            }
+        });
+}
+
+
+/**
+ ** Maps field into image, which is only reallocated if its size differs from
+ ** the field's.
+ **/
+template<typename T>
+void MapColors(
+    const Colormap &colormap,
+    const ScalarField<T> &field,
+    double low,
+    double high,
+    wxImage &image,
+    const ConversionSettings &settings = ConversionSettings())
+{
+    if (field.IsEmpty())
+    {
+        return;
+    }
+
+    if (
+        !image.IsOk()
+        || image.GetWidth() != field.width
+        || image.GetHeight() != field.height)
+    {
+        image.Create(field.width, field.height, false);
+    }
+
+    MapColors(colormap, field, low, high, image.GetData(), settings);
+}
+
+
+// Maps field into frame, for display in an ImageView.
+template<typename T>
+void MapColors(
+    const Colormap &colormap,
+    const ScalarField<T> &field,
+    double low,
+    double high,
+    ImageFrame &frame,
+    const ConversionSettings &settings = ConversionSettings())
+{
+    frame.Resize(field.width, field.height);
+    MapColors(colormap, field, low, high, frame.rgb.data(), settings);
+}
+
+
+/**
+ ** Keeps a colormap, a value range, and the image they are rendered into.
+ **
+ ** The image keeps its storage while the size of the field is unchanged, so
+ ** rendering again after a new range or a new frame of the same size does not
+ ** allocate.
+ **/
+template<typename T>
+class ColormapRenderer
+{
+public:
+    ColormapRenderer(
+        const Colormap &colormap,
+        double low,
+        double high,
+        const ConversionSettings &settings = ConversionSettings())
+        :
+        colormap_(colormap),
+        low_(low),
+        high_(high),
+        settings_(settings),
+        field_(),
+        image_()
+    {
+
+    }
+
+    // The field is not copied, and must remain valid until it is replaced.
+    void SetField(const ScalarField<T> &field)
+    {
+        this->field_ = field;
+    }
+
+    void SetRange(double low, double high)
+    {
+        this->low_ = low;
+        this->high_ = high;
+    }
+
+    void SetColormap(const Colormap &colormap)
+    {
+        this->colormap_ = colormap;
+    }
+
+    double GetLow() const
+    {
+        return this->low_;
+    }
+
+    double GetHigh() const
+    {
+        return this->high_;
+    }
+
+    // Maps the field with the current colormap and range.
+    const wxImage & Render()
+    {
+        MapColors(
+            this->colormap_,
+            this->field_,
+            this->low_,
+            this->high_,
+            this->image_,
+            this->settings_);
+
+        return this->image_;
+    }
+
+    const wxImage & GetImage() const
+    {
+        return this->image_;
+    }
+
+private:
+    Colormap colormap_;
+    double low_;
+    double high_;
+    ConversionSettings settings_;
+    ScalarField<T> field_;
+    wxImage image_;
+};
+
+
+/**
+ ** Sets the range of a ColormapRenderer from the values of two pex Range
+ ** controls, like those of a pair of sliders, and re-renders when either
+ ** changes.
+ **
+ ** onRender is called after each render, to show the new image.
+ **/
+template<typename T, typename RangeControl>
+class ColormapRange
+{
+public:
+    static constexpr auto observerName = "wxpex::ColormapRange";
+
+    using Type = typename RangeControl::Value::Type;
+    using Terminus = pex::Terminus<ColormapRange, typename RangeControl::Value>;
+    using OnRender = std::function<void(const wxImage &)>;
+
+    ColormapRange(
+        ColormapRenderer<T> &renderer,
+        RangeControl low,
+        RangeControl high,
+        OnRender onRender)
+        :
+        renderer_(renderer),
+        low_(this, low.value, &ColormapRange::OnValue_),
+        high_(this, high.value, &ColormapRange::OnValue_),
+        onRender_(onRender)
+    {
+        this->renderer_.SetRange(
+            static_cast<double>(this->low_.Get()),
+            static_cast<double>(this->high_.Get()));
+    }
+
+private:
+    void OnValue_(Type)
+    {
+        this->renderer_.SetRange(
+            static_cast<double>(this->low_.Get()),
+            static_cast<double>(this->high_.Get()));
+
+        auto &image = this->renderer_.Render();
+
+        if (this->onRender_)
+        {
+            this->onRender_(image);
+        }
+    }
+
+    ColormapRenderer<T> &renderer_;
+    Terminus low_;
+    Terminus high_;
+    OnRender onRender_;
+};
+
+
+} // end namespace wxpex
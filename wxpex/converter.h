@@ -2,6 +2,7 @@
 
 
 #include <pex/converter.h>
+#include "wxpex/chars_converter.h"
 
 
 namespace wxpex
@@ -40,4 +41,23 @@ using Converter =
     pex::Converter<typename Control::Type, ViewTraits<10, width, precision>>;
 
 
+/**
+ ** The same formats, produced by CharsConverter. These avoid allocating an
+ ** intermediate std::string, and ToString returns a wxString.
+ **/
+template<typename Control, int precision>
+using CharsPrecisionConverter =
+    CharsConverter<typename Control::Type, PreciseTraits<precision>>;
+
+
+template<typename Control, int width>
+using CharsWidthConverter =
+    CharsConverter<typename Control::Type, WidthTraits<width>>;
+
+
+template<typename Control, int width, int precision>
+using CharsViewConverter =
+    CharsConverter<typename Control::Type, ViewTraits<10, width, precision>>;
+
+
 } // end namespace wxpex
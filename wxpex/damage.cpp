@@ -0,0 +1,128 @@
+#include "wxpex/damage.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "wxpex/region.h"
+
+
+namespace wxpex
+{
+
+
+DamageTracker::DamageTracker(wxWindow *window)
+    :
+    window_(window),
+    damage_(),
+    isAll_(false)
+{
+
+}
+
+
+void DamageTracker::Add(const tau::Region<double> &region)
+{
+    if (this->isAll_)
+    {
+        return;
+    }
+
+    if (!this->damage_)
+    {
+        this->damage_ = region;
+        return;
+    }
+
+    auto &damage = *this->damage_;
+
+    auto left = std::min(damage.topLeft.x, region.topLeft.x);
+    auto top = std::min(damage.topLeft.y, region.topLeft.y);
+
+    auto right = std::max(
+        damage.topLeft.x + damage.size.width,
+        region.topLeft.x + region.size.width);
+
+    auto bottom = std::max(
+        damage.topLeft.y + damage.size.height,
+        region.topLeft.y + region.size.height);
+
+    damage.topLeft = tau::Point2d<double>(left, top);
+    damage.size = tau::Size<double>(right - left, bottom - top);
+}
+
+
+void DamageTracker::Add(const wxRect &rect)
+{
+    this->Add(ToRegion<double>(rect));
+}
+
+
+void DamageTracker::AddAll()
+{
+    this->isAll_ = true;
+    this->damage_.reset();
+}
+
+
+bool DamageTracker::IsEmpty() const
+{
+    return !this->isAll_ && !this->damage_;
+}
+
+
+std::optional<wxRect> DamageTracker::GetDamage() const
+{
+    auto clientRect = wxRect(this->window_->GetClientSize());
+
+    if (this->isAll_)
+    {
+        return clientRect;
+    }
+
+    if (!this->damage_)
+    {
+        return {};
+    }
+
+    // Round outward, so that partially covered pixels are redrawn.
+    auto &damage = *this->damage_;
+    auto left = std::floor(damage.topLeft.x);
+    auto top = std::floor(damage.topLeft.y);
+    auto right = std::ceil(damage.topLeft.x + damage.size.width);
+    auto bottom = std::ceil(damage.topLeft.y + damage.size.height);
+
+    tau::Region<double> pixels{{
+        tau::Point2d<double>(left, top),
+        tau::Size<double>(right - left, bottom - top)}};
+
+    auto result = ToWxRect(pixels).Intersect(clientRect);
+
+    if (result.IsEmpty())
+    {
+        return {};
+    }
+
+    return result;
+}
+
+
+void DamageTracker::Refresh(bool eraseBackground)
+{
+    auto damage = this->GetDamage();
+    this->Clear();
+
+    if (damage)
+    {
+        this->window_->RefreshRect(*damage, eraseBackground);
+    }
+}
+
+
+void DamageTracker::Clear()
+{
+    this->isAll_ = false;
+    this->damage_.reset();
+}
+
+
+} // end namespace wxpex
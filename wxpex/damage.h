@@ -0,0 +1,56 @@
+#pragma once
+
+
+#include <optional>
+#include <tau/region.h>
+
+#include "wxpex/wxshim.h"
+
+
+namespace wxpex
+{
+
+
+/**
+ ** Accumulates the areas of a custom-painted window that need to be redrawn,
+ ** so that only the union of what changed is invalidated instead of the whole
+ ** client area.
+ **
+ ** Regions are in client coordinates. A region is rounded outward to whole
+ ** pixels, and clipped to the client area when the window is refreshed.
+ **
+ ** Must only be used from the wx event loop thread.
+ **/
+class DamageTracker
+{
+public:
+    DamageTracker(wxWindow *window);
+
+    void Add(const tau::Region<double> &region);
+
+    void Add(const wxRect &rect);
+
+    // Mark the whole client area as damaged.
+    void AddAll();
+
+    bool IsEmpty() const;
+
+    // The union of the damaged regions, clipped to the client area.
+    std::optional<wxRect> GetDamage() const;
+
+    /**
+     ** Invalidate the damaged area with RefreshRect, and start accumulating
+     ** again.
+     **/
+    void Refresh(bool eraseBackground = true);
+
+    void Clear();
+
+private:
+    wxWindow *window_;
+    std::optional<tau::Region<double>> damage_;
+    bool isAll_;
+};
+
+
+} // end namespace wxpex
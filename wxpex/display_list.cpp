@@ -0,0 +1,590 @@
+#include "wxpex/display_list.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace wxpex
+{
+
+
+namespace
+{
+
+
+wxRect2DDouble GetPointsBounds(const std::vector<wxPoint2DDouble> &points)
+{
+    if (points.empty())
+    {
+        return {};
+    }
+
+    auto left = points.front().m_x;
+    auto right = left;
+    auto top = points.front().m_y;
+    auto bottom = top;
+
+    for (auto &point: points)
+    {
+        left = std::min(left, point.m_x);
+        right = std::max(right, point.m_x);
+        top = std::min(top, point.m_y);
+        bottom = std::max(bottom, point.m_y);
+    }
+
+    return {left, top, right - left, bottom - top};
+}
+
+
+wxRect ToEnclosingRect(const wxRect2DDouble &rectangle)
+{
+    auto left = static_cast<int>(std::floor(rectangle.GetLeft()));
+    auto top = static_cast<int>(std::floor(rectangle.GetTop()));
+    auto right = static_cast<int>(std::ceil(rectangle.GetRight()));
+    auto bottom = static_cast<int>(std::ceil(rectangle.GetBottom()));
+
+    return wxRect(left, top, right - left, bottom - top);
+}
+
+
+template<typename Shape>
+void DrawPath(
+    GraphicsContext &context,
+    const wxGraphicsPath &path,
+    const Shape &shape)
+{
+    switch (shape.mode)
+    {
+        case (DisplayNode::Mode::fill):
+            context->FillPath(path);
+            break;
+
+        case (DisplayNode::Mode::stroke):
+            context->StrokePath(path);
+            break;
+
+        case (DisplayNode::Mode::fillAndStroke):
+            context->DrawPath(path);
+            break;
+
+        default:
+            throw std::logic_error("Unknown DisplayNode::Mode");
+    }
+}
+
+
+} // end anonymous namespace
+
+
+wxRect2DDouble TransformBounds(
+    const GraphicsMatrix &transform,
+    const wxRect2DDouble &bounds)
+{
+    std::array<GraphicsMatrix::Point, 4> corners{{
+        {bounds.GetLeft(), bounds.GetTop()},
+        {bounds.GetRight(), bounds.GetTop()},
+        {bounds.GetRight(), bounds.GetBottom()},
+        {bounds.GetLeft(), bounds.GetBottom()}}};
+
+    transform.TransformPoints(corners.data(), corners.size());
+
+    auto left = corners[0].x;
+    auto right = left;
+    auto top = corners[0].y;
+    auto bottom = top;
+
+    for (auto &corner: corners)
+    {
+        left = std::min(left, corner.x);
+        right = std::max(right, corner.x);
+        top = std::min(top, corner.y);
+        bottom = std::max(bottom, corner.y);
+    }
+
+    return {left, top, right - left, bottom - top};
+}
+
+
+DisplayNode::DisplayNode()
+    :
+    commands_(),
+    bounds_(),
+    penWidth_(1.0),
+    realized_(),
+    renderer_(nullptr)
+{
+
+}
+
+
+DisplayNode & DisplayNode::SetPen(const wxGraphicsPenInfo &penInfo)
+{
+    this->penWidth_ = penInfo.GetWidth();
+    this->commands_.push_back(PenCommand{penInfo});
+
+    return *this;
+}
+
+
+DisplayNode & DisplayNode::SetPen(const wxPen &pen)
+{
+    // The same conversion made by wxGraphicsContext::CreatePen.
+    auto penInfo = wxGraphicsPenInfo(
+        pen.GetColour(),
+        pen.GetWidth(),
+        pen.GetStyle());
+
+    penInfo.Cap(pen.GetCap()).Join(pen.GetJoin());
+
+    if (pen.GetStyle() == wxPENSTYLE_TRANSPARENT)
+    {
+        penInfo.Width(0.0);
+    }
+
+    return this->SetPen(penInfo);
+}
+
+
+DisplayNode & DisplayNode::SetBrush(const wxBrush &brush)
+{
+    this->commands_.push_back(BrushCommand{brush});
+
+    return *this;
+}
+
+
+DisplayNode & DisplayNode::SetLinearGradientBrush(
+    const wxPoint2DDouble &begin,
+    const wxPoint2DDouble &end,
+    const wxGraphicsGradientStops &stops)
+{
+    this->commands_.push_back(LinearGradientCommand{begin, end, stops});
+
+    return *this;
+}
+
+
+DisplayNode & DisplayNode::SetRadialGradientBrush(
+    const wxPoint2DDouble &origin,
+    const wxPoint2DDouble &center,
+    double radius,
+    const wxGraphicsGradientStops &stops)
+{
+    this->commands_.push_back(
+        RadialGradientCommand{origin, center, radius, stops});
+
+    return *this;
+}
+
+
+DisplayNode & DisplayNode::StrokeLine(
+    const wxPoint2DDouble &begin,
+    const wxPoint2DDouble &end)
+{
+    return this->DrawLines({begin, end}, false, Mode::stroke);
+}
+
+
+DisplayNode & DisplayNode::DrawLines(
+    const std::vector<wxPoint2DDouble> &points,
+    bool isClosed,
+    Mode mode)
+{
+    if (points.empty())
+    {
+        // Nothing is drawn, so nothing is added to the bounds.
+        return *this;
+    }
+
+    auto bounds = GetPointsBounds(points);
+    this->AddShape_(LinesCommand{points, isClosed, mode}, bounds);
+
+    return *this;
+}
+
+
+DisplayNode & DisplayNode::DrawRectangle(
+    const wxRect2DDouble &rectangle,
+    Mode mode)
+{
+    this->AddShape_(RectangleCommand{rectangle, 0.0, mode}, rectangle);
+
+    return *this;
+}
+
+
+DisplayNode & DisplayNode::DrawRoundedRectangle(
+    const wxRect2DDouble &rectangle,
+    double radius,
+    Mode mode)
+{
+    this->AddShape_(RectangleCommand{rectangle, radius, mode}, rectangle);
+
+    return *this;
+}
+
+
+DisplayNode & DisplayNode::DrawEllipse(
+    const wxRect2DDouble &rectangle,
+    Mode mode)
+{
+    this->AddShape_(EllipseCommand{rectangle, mode}, rectangle);
+
+    return *this;
+}
+
+
+void DisplayNode::Clear()
+{
+    this->commands_.clear();
+    this->bounds_.reset();
+    this->penWidth_ = 1.0;
+    this->realized_.clear();
+    this->renderer_ = nullptr;
+}
+
+
+bool DisplayNode::IsEmpty() const
+{
+    return this->commands_.empty();
+}
+
+
+const std::optional<wxRect2DDouble> & DisplayNode::GetBounds() const
+{
+    return this->bounds_;
+}
+
+
+void DisplayNode::Draw(GraphicsContext &context) const
+{
+    if (this->commands_.empty())
+    {
+        return;
+    }
+
+    this->Realize_(context->GetRenderer());
+
+    for (size_t i = 0; i < this->commands_.size(); ++i)
+    {
+        const auto &command = this->commands_[i];
+        const auto &realized = this->realized_[i];
+
+        if (auto pen = std::get_if<wxGraphicsPen>(&realized))
+        {
+            context->SetPen(*pen);
+        }
+        else if (auto brush = std::get_if<wxGraphicsBrush>(&realized))
+        {
+            context->SetBrush(*brush);
+        }
+        else if (auto path = std::get_if<wxGraphicsPath>(&realized))
+        {
+            std::visit(
+                [&context, path](const auto &shape) -> void
+                {
+                    using Shape = std::decay_t<decltype(shape)>;
+
+                    if constexpr (
+                        std::is_same_v<Shape, LinesCommand>
+                        || std::is_same_v<Shape, RectangleCommand>
+                        || std::is_same_v<Shape, EllipseCommand>)
+                    {
+                        DrawPath(context, *path, shape);
+                    }
+                },
+                command);
+        }
+    }
+}
+
+
+void DisplayNode::AddShape_(
+    const Command &command,
+    const wxRect2DDouble &bounds)
+{
+    auto expanded = bounds;
+
+    bool isStroked = std::visit(
+        [](const auto &shape) -> bool
+        {
+            using Shape = std::decay_t<decltype(shape)>;
+
+            if constexpr (
+                std::is_same_v<Shape, LinesCommand>
+                || std::is_same_v<Shape, RectangleCommand>
+                || std::is_same_v<Shape, EllipseCommand>)
+            {
+                return shape.mode != Mode::fill;
+            }
+            else
+            {
+                return false;
+            }
+        },
+        command);
+
+    // Allow one extra pixel for antialiasing.
+    auto margin = 1.0;
+
+    if (isStroked)
+    {
+        margin += this->penWidth_ / 2.0;
+    }
+
+    expanded.Inset(-margin, -margin);
+
+    if (this->bounds_)
+    {
+        this->bounds_->Union(expanded);
+    }
+    else
+    {
+        this->bounds_ = expanded;
+    }
+
+    this->commands_.push_back(command);
+}
+
+
+void DisplayNode::Realize_(wxGraphicsRenderer *renderer) const
+{
+    if (
+        this->renderer_ == renderer
+        && this->realized_.size() == this->commands_.size())
+    {
+        return;
+    }
+
+    // Graphics objects can only be used with the renderer that created them.
+    this->realized_.clear();
+    this->realized_.reserve(this->commands_.size());
+
+    for (auto &command: this->commands_)
+    {
+        this->realized_.push_back(RealizeCommand_(renderer, command));
+    }
+
+    this->renderer_ = renderer;
+}
+
+
+DisplayNode::Realized DisplayNode::RealizeCommand_(
+    wxGraphicsRenderer *renderer,
+    const Command &command)
+{
+    return std::visit(
+        [renderer](const auto &value) -> Realized
+        {
+            using Value = std::decay_t<decltype(value)>;
+
+            if constexpr (std::is_same_v<Value, PenCommand>)
+            {
+                return renderer->CreatePen(value.penInfo);
+            }
+            else if constexpr (std::is_same_v<Value, BrushCommand>)
+            {
+                return renderer->CreateBrush(value.brush);
+            }
+            else if constexpr (std::is_same_v<Value, LinearGradientCommand>)
+            {
+                return renderer->CreateLinearGradientBrush(
+                    value.begin.m_x,
+                    value.begin.m_y,
+                    value.end.m_x,
+                    value.end.m_y,
+                    value.stops);
+            }
+            else if constexpr (std::is_same_v<Value, RadialGradientCommand>)
+            {
+                return renderer->CreateRadialGradientBrush(
+                    value.origin.m_x,
+                    value.origin.m_y,
+                    value.center.m_x,
+                    value.center.m_y,
+                    value.radius,
+                    value.stops);
+            }
+            else
+            {
+                auto path = renderer->CreatePath();
+
+                if constexpr (std::is_same_v<Value, LinesCommand>)
+                {
+                    if (!value.points.empty())
+                    {
+                        path.MoveToPoint(value.points.front());
+
+                        for (size_t i = 1; i < value.points.size(); ++i)
+                        {
+                            path.AddLineToPoint(value.points[i]);
+                        }
+
+                        if (value.isClosed)
+                        {
+                            path.CloseSubpath();
+                        }
+                    }
+                }
+                else if constexpr (std::is_same_v<Value, RectangleCommand>)
+                {
+                    const auto &rectangle = value.rectangle;
+
+                    if (value.radius > 0.0)
+                    {
+                        path.AddRoundedRectangle(
+                            rectangle.m_x,
+                            rectangle.m_y,
+                            rectangle.m_width,
+                            rectangle.m_height,
+                            value.radius);
+                    }
+                    else
+                    {
+                        path.AddRectangle(
+                            rectangle.m_x,
+                            rectangle.m_y,
+                            rectangle.m_width,
+                            rectangle.m_height);
+                    }
+                }
+                else
+                {
+                    static_assert(std::is_same_v<Value, EllipseCommand>);
+
+                    path.AddEllipse(
+                        value.rectangle.m_x,
+                        value.rectangle.m_y,
+                        value.rectangle.m_width,
+                        value.rectangle.m_height);
+                }
+
+                return path;
+            }
+        },
+        command);
+}
+
+
+DisplayList::NodeId DisplayList::AddNode(const Record &record)
+{
+    auto nodeId = this->entries_.size();
+    this->entries_.push_back({DisplayNode(), true});
+    record(this->entries_.back().node);
+
+    return nodeId;
+}
+
+
+void DisplayList::Update(NodeId nodeId, const Record &record)
+{
+    auto &node = this->GetEntry_(nodeId).node;
+    node.Clear();
+    record(node);
+}
+
+
+void DisplayList::SetVisible(NodeId nodeId, bool isVisible)
+{
+    this->GetEntry_(nodeId).isVisible = isVisible;
+}
+
+
+bool DisplayList::IsVisible(NodeId nodeId) const
+{
+    return this->GetEntry_(nodeId).isVisible;
+}
+
+
+const DisplayNode & DisplayList::GetNode(NodeId nodeId) const
+{
+    return this->GetEntry_(nodeId).node;
+}
+
+
+size_t DisplayList::GetCount() const
+{
+    return this->entries_.size();
+}
+
+
+void DisplayList::Clear()
+{
+    this->entries_.clear();
+}
+
+
+void DisplayList::Draw(GraphicsContext &context) const
+{
+    for (auto &entry: this->entries_)
+    {
+        if (entry.isVisible)
+        {
+            entry.node.Draw(context);
+        }
+    }
+}
+
+
+void DisplayList::Draw(
+    GraphicsContext &context,
+    const wxRegion &updateRegion) const
+{
+    // Bounds are recorded in user coordinates, and the region is in window
+    // coordinates.
+    GraphicsMatrix transform(context->GetTransform());
+    bool isIdentity = transform.IsIdentity();
+
+    for (auto &entry: this->entries_)
+    {
+        if (!entry.isVisible)
+        {
+            continue;
+        }
+
+        auto &bounds = entry.node.GetBounds();
+
+        if (!bounds)
+        {
+            // Nothing to draw.
+            continue;
+        }
+
+        auto windowBounds =
+            isIdentity ? *bounds : TransformBounds(transform, *bounds);
+
+        if (updateRegion.Contains(ToEnclosingRect(windowBounds)) == wxOutRegion)
+        {
+            continue;
+        }
+
+        entry.node.Draw(context);
+    }
+}
+
+
+DisplayList::Entry_ & DisplayList::GetEntry_(NodeId nodeId)
+{
+    if (nodeId >= this->entries_.size())
+    {
+        throw std::out_of_range("Unknown DisplayList node");
+    }
+
+    return this->entries_[nodeId];
+}
+
+
+const DisplayList::Entry_ & DisplayList::GetEntry_(NodeId nodeId) const
+{
+    if (nodeId >= this->entries_.size())
+    {
+        throw std::out_of_range("Unknown DisplayList node");
+    }
+
+    return this->entries_[nodeId];
+}
+
+
+} // end namespace wxpex
@@ -0,0 +1,258 @@
+/**
+  * @file display_list.h
+  *
+  * @brief A retained list of draw commands that caches the graphics objects
+  * it creates.
+  *
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "wxpex/ignores.h"
+
+WXSHIM_PUSH_IGNORES
+#include <wx/graphics.h>
+#include <wx/geometry.h>
+#include <wx/region.h>
+WXSHIM_POP_IGNORES
+
+#include "wxpex/graphics.h"
+
+
+namespace wxpex
+{
+
+
+// The axis-aligned box that contains bounds after transform.
+wxRect2DDouble TransformBounds(
+    const GraphicsMatrix &transform,
+    const wxRect2DDouble &bounds);
+
+
+/**
+ ** The draw commands of one node in a DisplayList.
+ **
+ ** Commands are recorded with the fluent interface, and replayed by Draw.
+ ** The wxGraphicsPen, wxGraphicsBrush, and wxGraphicsPath objects needed for
+ ** replay are created on the first Draw, and reused until the node is
+ ** recorded again or a context from a different renderer is used.
+ **/
+class DisplayNode
+{
+public:
+    enum class Mode
+    {
+        fill,
+        stroke,
+        fillAndStroke
+    };
+
+    DisplayNode();
+
+    // All recording functions return a reference to this instance so they can
+    // be chained.
+    //
+    // node.SetPen(wxPen(color, 2)).StrokeLine(begin, end);
+
+    DisplayNode & SetPen(const wxGraphicsPenInfo &penInfo);
+
+    DisplayNode & SetPen(const wxPen &pen);
+
+    DisplayNode & SetBrush(const wxBrush &brush);
+
+    DisplayNode & SetLinearGradientBrush(
+        const wxPoint2DDouble &begin,
+        const wxPoint2DDouble &end,
+        const wxGraphicsGradientStops &stops);
+
+    DisplayNode & SetRadialGradientBrush(
+        const wxPoint2DDouble &origin,
+        const wxPoint2DDouble &center,
+        double radius,
+        const wxGraphicsGradientStops &stops);
+
+    DisplayNode & StrokeLine(
+        const wxPoint2DDouble &begin,
+        const wxPoint2DDouble &end);
+
+    DisplayNode & DrawLines(
+        const std::vector<wxPoint2DDouble> &points,
+        bool isClosed,
+        Mode mode = Mode::fillAndStroke);
+
+    DisplayNode & DrawRectangle(
+        const wxRect2DDouble &rectangle,
+        Mode mode = Mode::fillAndStroke);
+
+    DisplayNode & DrawRoundedRectangle(
+        const wxRect2DDouble &rectangle,
+        double radius,
+        Mode mode = Mode::fillAndStroke);
+
+    DisplayNode & DrawEllipse(
+        const wxRect2DDouble &rectangle,
+        Mode mode = Mode::fillAndStroke);
+
+    // Discard the recorded commands and the graphics objects created for them.
+    void Clear();
+
+    bool IsEmpty() const;
+
+    /**
+     ** The area covered by the recorded shapes, including half the width of
+     ** the pen used to stroke them.
+     **/
+    const std::optional<wxRect2DDouble> & GetBounds() const;
+
+    void Draw(GraphicsContext &context) const;
+
+private:
+    struct PenCommand
+    {
+        wxGraphicsPenInfo penInfo;
+    };
+
+    struct BrushCommand
+    {
+        wxBrush brush;
+    };
+
+    struct LinearGradientCommand
+    {
+        wxPoint2DDouble begin;
+        wxPoint2DDouble end;
+        wxGraphicsGradientStops stops;
+    };
+
+    struct RadialGradientCommand
+    {
+        wxPoint2DDouble origin;
+        wxPoint2DDouble center;
+        double radius;
+        wxGraphicsGradientStops stops;
+    };
+
+    struct LinesCommand
+    {
+        std::vector<wxPoint2DDouble> points;
+        bool isClosed;
+        Mode mode;
+    };
+
+    struct RectangleCommand
+    {
+        wxRect2DDouble rectangle;
+        double radius;
+        Mode mode;
+    };
+
+    struct EllipseCommand
+    {
+        wxRect2DDouble rectangle;
+        Mode mode;
+    };
+
+    using Command = std::variant
+    <
+        PenCommand,
+        BrushCommand,
+        LinearGradientCommand,
+        RadialGradientCommand,
+        LinesCommand,
+        RectangleCommand,
+        EllipseCommand
+    >;
+
+    using Realized = std::variant
+    <
+        std::monostate,
+        wxGraphicsPen,
+        wxGraphicsBrush,
+        wxGraphicsPath
+    >;
+
+    void AddShape_(const Command &command, const wxRect2DDouble &bounds);
+
+    void Realize_(wxGraphicsRenderer *renderer) const;
+
+    static Realized RealizeCommand_(
+        wxGraphicsRenderer *renderer,
+        const Command &command);
+
+    std::vector<Command> commands_;
+    std::optional<wxRect2DDouble> bounds_;
+    double penWidth_;
+
+    // Created on demand by Draw.
+    mutable std::vector<Realized> realized_;
+    mutable wxGraphicsRenderer *renderer_;
+};
+
+
+/**
+ ** An ordered collection of DisplayNodes, drawn first to last.
+ **
+ ** Each node is recorded by a function that is only called again when the
+ ** node is updated, so the paths, pens, and brushes of unchanged nodes are
+ ** reused on every paint. Draw skips nodes that are hidden or that lie
+ ** outside of the region being repainted.
+ **
+ ** Because nodes may be skipped, a node does not inherit the pen or brush of
+ ** the nodes drawn before it. Each node sets its own.
+ **
+ ** Must only be used from the wx event loop thread.
+ **/
+class DisplayList
+{
+public:
+    using NodeId = size_t;
+    using Record = std::function<void(DisplayNode &node)>;
+
+    // Append a node, drawn above the existing nodes.
+    NodeId AddNode(const Record &record);
+
+    // Replace the commands of one node, leaving the others untouched.
+    void Update(NodeId nodeId, const Record &record);
+
+    void SetVisible(NodeId nodeId, bool isVisible);
+
+    bool IsVisible(NodeId nodeId) const;
+
+    const DisplayNode & GetNode(NodeId nodeId) const;
+
+    size_t GetCount() const;
+
+    void Clear();
+
+    void Draw(GraphicsContext &context) const;
+
+    /**
+     ** Draws only the nodes that intersect updateRegion, which is in window
+     ** coordinates, as given by wxWindow::GetUpdateRegion. Node bounds are
+     ** mapped through the current transform of context before they are
+     ** compared, so drawing may be translated, scaled, or rotated.
+     **/
+    void Draw(GraphicsContext &context, const wxRegion &updateRegion) const;
+
+private:
+    struct Entry_
+    {
+        DisplayNode node;
+        bool isVisible;
+    };
+
+    Entry_ & GetEntry_(NodeId nodeId);
+    const Entry_ & GetEntry_(NodeId nodeId) const;
+
+    std::vector<Entry_> entries_;
+};
+
+
+} // end namespace wxpex
@@ -18,6 +18,7 @@
 #include "wxpex/converter.h"
 #include "wxpex/wxshim.h"
 #include "wxpex/size.h"
+#include "wxpex/startup_profiler.h"
 
 
 namespace wxpex
@@ -73,6 +74,7 @@ private:
 
         REGISTER_PEX_PARENT(value_);
         this->value_.Connect(&Field::OnValueChanged_);
+        PROFILE_WIDGET_CONNECTED(this)
 
         // A sizer is required to allow the text control to be managed by
         // a hierarchy of sizers.
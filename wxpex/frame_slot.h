@@ -0,0 +1,148 @@
+#pragma once
+
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+
+namespace wxpex
+{
+
+
+/**
+ ** Hands the newest complete frame from one writer thread to one reader
+ ** thread without blocking either, and without copying.
+ **
+ ** There are three buffers. The writer owns one and fills it, then publishes
+ ** it, exchanging it for the buffer in the middle. The reader owns another,
+ ** and exchanges it for the middle buffer only when a newer frame has been
+ ** published. Frames published faster than the reader acquires them are
+ ** dropped, and the reader always gets the newest.
+ **
+ ** Buffers are reused, so a frame type that keeps its storage, like
+ ** ImageFrame, does not allocate once each buffer has been filled.
+ **
+ ** Share the slot between the threads with a std::shared_ptr.
+ **/
+template<typename T>
+class FrameSlot
+{
+public:
+    FrameSlot()
+        :
+        buffers_{},
+        writeIndex_(0),
+        middle_(1),
+        readIndex_(2)
+    {
+
+    }
+
+    FrameSlot(const FrameSlot &) = delete;
+    FrameSlot & operator=(const FrameSlot &) = delete;
+
+    // Writer thread: the buffer to fill before calling Publish.
+    T & GetWriteBuffer()
+    {
+        return this->buffers_[this->writeIndex_];
+    }
+
+    // Writer thread: makes the write buffer the newest frame.
+    void Publish()
+    {
+        auto previous = this->middle_.exchange(
+            static_cast<uint8_t>(this->writeIndex_ | isNewFlag_),
+            std::memory_order_acq_rel);
+
+        this->writeIndex_ = previous & indexMask_;
+    }
+
+    // Reader thread: true if a frame was published since the last Acquire.
+    bool HasNewFrame() const
+    {
+        return (this->middle_.load(std::memory_order_acquire) & isNewFlag_)
+            != 0;
+    }
+
+    /**
+     ** Reader thread: takes the newest frame, if there is one.
+     **
+     ** @return true if the read buffer now holds a new frame.
+     **/
+    bool Acquire()
+    {
+        if (!this->HasNewFrame())
+        {
+            return false;
+        }
+
+        auto previous = this->middle_.exchange(
+            this->readIndex_,
+            std::memory_order_acq_rel);
+
+        this->readIndex_ = previous & indexMask_;
+
+        return true;
+    }
+
+    // Reader thread: the most recently acquired frame.
+    T & GetReadBuffer()
+    {
+        return this->buffers_[this->readIndex_];
+    }
+
+    const T & GetReadBuffer() const
+    {
+        return this->buffers_[this->readIndex_];
+    }
+
+private:
+    static constexpr uint8_t indexMask_ = 0x3;
+    static constexpr uint8_t isNewFlag_ = 0x4;
+
+    std::array<T, 3> buffers_;
+
+    // Only used by the writer.
+    uint8_t writeIndex_;
+
+    // The index of the buffer between the threads, and whether it is new.
+    std::atomic<uint8_t> middle_;
+
+    // Only used by the reader.
+    uint8_t readIndex_;
+};
+
+
+// An 8-bit RGB image, without the reference counting of wxImage, so it can
+// be filled in a worker thread.
+struct ImageFrame
+{
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> rgb;
+
+    /**
+     ** Sets the size, keeping the storage when it is large enough.
+     ** Pixel values are unspecified until written.
+     **/
+    void Resize(int width_, int height_)
+    {
+        this->width = width_;
+        this->height = height_;
+        this->rgb.resize(
+            static_cast<size_t>(width_) * static_cast<size_t>(height_) * 3);
+    }
+
+    bool IsEmpty() const
+    {
+        return this->width <= 0 || this->height <= 0;
+    }
+};
+
+
+using ImageSlot = FrameSlot<ImageFrame>;
+
+
+} // end namespace wxpex
@@ -12,6 +12,18 @@ Gauge::Gauge(
     GaugeControl control,
     Style style)
     :
+    Gauge(parent, control, ReadoutSettings(), style)
+{
+
+}
+
+
+Gauge::Gauge(
+    wxWindow *parent,
+    GaugeControl control,
+    const ReadoutSettings &readoutSettings,
+    Style style)
+    :
     Base(
         parent,
         wxID_ANY,
@@ -19,7 +31,13 @@ Gauge::Gauge(
         wxDefaultPosition,
         wxDefaultSize,
         GaugeStyle(style)),
-    endpoints_(USE_REGISTER_PEX_NAME(this, "wxpex::Gauge"), control)
+    endpoints_(USE_REGISTER_PEX_NAME(this, "wxpex::Gauge"), control),
+    throttle_(
+        readoutSettings,
+        [this](const Readout<size_t> &readout) -> void
+        {
+            this->OnReadout_(readout);
+        })
 {
     this->endpoints_.value.Connect(&Gauge::OnValue_);
     this->endpoints_.maximum.Connect(&Gauge::OnMaximum_);
@@ -29,6 +47,13 @@ Gauge::Gauge(
 
 void Gauge::OnValue_(size_t value)
 {
+    this->throttle_.Update(value);
+}
+
+
+void Gauge::OnReadout_(const Readout<size_t> &readout)
+{
+    size_t value = readout.value;
     size_t maximum = this->endpoints_.control.maximum.Get();
 
     if (maximum == 0)
@@ -57,13 +82,28 @@ ValueGauge::ValueGauge(
     GaugeControl control,
     Style style)
     :
-    wxControl(parent, wxID_ANY),
-    value_(USE_REGISTER_PEX_NAME(this, "wxpex::ValueGauge"), control.value)
+    ValueGauge(parent, control, ReadoutSettings(), style)
+{
+
+}
+
+
+ValueGauge::ValueGauge(
+    wxWindow *parent,
+    GaugeControl control,
+    const ReadoutSettings &readoutSettings,
+    Style style)
+    :
+    wxControl(parent, wxID_ANY)
 {
     using ValueControl = decltype(control.value);
-    using IntConverter = Converter<ValueControl, -1, -1>;
-    auto gauge = new Gauge(this, control, style);
-    auto view = new View<ValueControl, IntConverter>(this, control.value);
+    using IntConverter = CharsViewConverter<ValueControl, -1, -1>;
+    auto gauge = new Gauge(this, control, readoutSettings, style);
+
+    auto view = new View<ValueControl, IntConverter>(
+        this,
+        control.value,
+        readoutSettings);
 
     // Use a mono-spaced font for display so that the width of the view
     // remains constant as the value changes.
@@ -88,13 +128,13 @@ ValueGauge::ValueGauge(
             : wxALIGN_CENTER);
 
     this->SetSizerAndFit(sizer.release());
-    this->value_.Connect(&ValueGauge::OnValue_);
-}
-
 
-void ValueGauge::OnValue_(size_t)
-{
-    this->Layout();
+    // The view's throttle decides when its label changes size.
+    view->SetOnRefresh(
+        [this]() -> void
+        {
+            this->Layout();
+        });
 }
 
 
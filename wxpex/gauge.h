@@ -11,6 +11,7 @@ WXSHIM_POP_IGNORES
 
 #include "wxpex/async.h"
 #include "wxpex/style.h"
+#include "wxpex/throttle.h"
 
 
 namespace wxpex
@@ -139,12 +140,22 @@ public:
         GaugeControl control,
         Style style = Style::horizontal);
 
+    // Limits how often the gauge is redrawn. See ReadoutSettings.
+    Gauge(
+        wxWindow *parent,
+        GaugeControl control,
+        const ReadoutSettings &readoutSettings,
+        Style style = Style::horizontal);
+
 private:
     void OnValue_(size_t value);
 
+    void OnReadout_(const Readout<size_t> &readout);
+
     void OnMaximum_(size_t maximum);
 
     pex::EndpointGroup<Gauge, GaugeControl> endpoints_;
+    Throttle<size_t> throttle_;
 };
 
 
@@ -160,10 +171,16 @@ public:
         GaugeControl control,
         Style style = Style::horizontal);
 
-    void OnValue_(size_t);
-
-private:
-    pex::Terminus<ValueGauge, ValueControl> value_;
+    /**
+     ** The gauge and its readout share a RefreshTimer, so both are updated on
+     ** the same tick. With ReadoutSettings::showExtrema, the readout also
+     ** displays the range of values received since the last refresh.
+     **/
+    ValueGauge(
+        wxWindow *parent,
+        GaugeControl control,
+        const ReadoutSettings &readoutSettings,
+        Style style = Style::horizontal);
 };
 
 
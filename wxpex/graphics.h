@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cmath>
 #include <vector>
 #include <optional>
 #include <fields/fields.h>
@@ -8,6 +10,7 @@
 #include <jive/create_exception.h>
 #include <tau/size.h>
 #include <tau/scale.h>
+#include <tau/vector2d.h>
 
 #include "wxpex/ignores.h"
 
@@ -396,8 +399,23 @@ auto CreateGraphicsControl(wxWindow *parent, Control control)
 }
 
 
+/**
+ ** The six coefficients of a wxGraphicsMatrix.
+ **
+ ** Points map as they do in wxGraphicsMatrix::TransformPoint:
+ **
+ **     x' = a * x + c * y + tx
+ **     y' = b * x + d * y + ty
+ **
+ ** The scale, rotation, and inverse are computed from the coefficients on
+ ** each call, and the batch transforms compute the inverse once per batch.
+ ** Nothing is cached, so a const GraphicsMatrix may be read from several
+ ** threads at once.
+ **/
 struct GraphicsMatrix
 {
+    using Point = tau::Point2d<double>;
+
     GraphicsMatrix(const wxGraphicsMatrix &graphicsMatrix)
     {
         graphicsMatrix.Get(
@@ -409,6 +427,24 @@ struct GraphicsMatrix
             &this->ty);
     }
 
+    GraphicsMatrix(
+        double a_,
+        double b_,
+        double c_,
+        double d_,
+        double tx_,
+        double ty_)
+        :
+        a(a_),
+        b(b_),
+        c(c_),
+        d(d_),
+        tx(tx_),
+        ty(ty_)
+    {
+
+    }
+
     void ToWxGraphicsMatrix(wxGraphicsMatrix &outGraphicsMatrix)
     {
         outGraphicsMatrix.Set(
@@ -471,20 +507,12 @@ struct GraphicsMatrix
 
     tau::Scale<double> GetScale() const
     {
-        // This assumes that rotation was applied last.
-        // If scale was applied after rotation, you will not get what you
-        // expect.
-        return {
-            std::sqrt(this->b * this->b + this->d * this->d),
-            std::sqrt(this->a * this->a + this->c * this->c)};
+        return this->Decompose_().scale;
     }
 
     double GetRotation() const
     {
-        auto scale = this->GetScale();
-        auto c_ = this->c / scale.horizontal;
-        auto d_ = this->d / scale.vertical;
-        return std::atan2(-c_, d_);
+        return this->Decompose_().rotation;
     }
 
     tau::Vector2d<double> GetTranslation() const
@@ -499,7 +527,68 @@ struct GraphicsMatrix
 
     void SetShear(const Shear<double> &shear)
     {
-        this->SetRotationMatrix(shear.GetMatrix() * this->GetRotationMatrix());
+        // Premultiply by the shear matrix, [[1, x], [y, 1]].
+        auto a_ = this->a + shear.x * this->c;
+        auto b_ = this->b + shear.x * this->d;
+        auto c_ = shear.y * this->a + this->c;
+        auto d_ = shear.y * this->b + this->d;
+
+        this->a = a_;
+        this->b = b_;
+        this->c = c_;
+        this->d = d_;
+    }
+
+    bool IsInvertible() const
+    {
+        return this->Decompose_().isInvertible;
+    }
+
+    Point TransformPoint(const Point &point) const
+    {
+        return {
+            this->a * point.x + this->c * point.y + this->tx,
+            this->b * point.x + this->d * point.y + this->ty};
+    }
+
+    // Maps from device coordinates back to user coordinates.
+    Point InverseTransformPoint(const Point &point) const
+    {
+        auto inverse = this->GetInverse_();
+
+        return {
+            inverse[0] * point.x + inverse[2] * point.y + inverse[4],
+            inverse[1] * point.x + inverse[3] * point.y + inverse[5]};
+    }
+
+    /**
+     ** Transforms count points in place.
+     **
+     ** The loop has no dependencies between points, so the compiler is free
+     ** to vectorize it.
+     **/
+    void TransformPoints(Point *points, size_t count) const
+    {
+        Transform_(
+            {this->a, this->b, this->c, this->d, this->tx, this->ty},
+            points,
+            count);
+    }
+
+    void TransformPoints(std::vector<Point> &points) const
+    {
+        this->TransformPoints(points.data(), points.size());
+    }
+
+    // Maps count points in place from device back to user coordinates.
+    void InverseTransformPoints(Point *points, size_t count) const
+    {
+        Transform_(this->GetInverse_(), points, count);
+    }
+
+    void InverseTransformPoints(std::vector<Point> &points) const
+    {
+        this->InverseTransformPoints(points.data(), points.size());
     }
 
     bool IsIdentity() const
@@ -527,6 +616,81 @@ struct GraphicsMatrix
         fields::Field(&GraphicsMatrix::d, "d"),
         fields::Field(&GraphicsMatrix::tx, "tx"),
         fields::Field(&GraphicsMatrix::ty, "ty"));
+
+private:
+    // a, b, c, d, tx, ty
+    using Coefficients = std::array<double, 6>;
+
+    struct Decomposition_
+    {
+        tau::Scale<double> scale;
+        double rotation;
+        bool isInvertible;
+        Coefficients inverse;
+    };
+
+    Decomposition_ Decompose_() const
+    {
+        Decomposition_ decomposition{};
+
+        // This assumes that rotation was applied last.
+        // If scale was applied after rotation, you will not get what you
+        // expect.
+        decomposition.scale = tau::Scale<double>{
+            std::sqrt(this->b * this->b + this->d * this->d),
+            std::sqrt(this->a * this->a + this->c * this->c)};
+
+        decomposition.rotation = std::atan2(
+            -this->c / decomposition.scale.horizontal,
+            this->d / decomposition.scale.vertical);
+
+        auto determinant = this->a * this->d - this->b * this->c;
+        decomposition.isInvertible = !(jive::About(determinant) == 0.0);
+
+        if (decomposition.isInvertible)
+        {
+            auto inverseA = this->d / determinant;
+            auto inverseB = -this->b / determinant;
+            auto inverseC = -this->c / determinant;
+            auto inverseD = this->a / determinant;
+
+            decomposition.inverse = {
+                inverseA,
+                inverseB,
+                inverseC,
+                inverseD,
+                -(inverseA * this->tx + inverseC * this->ty),
+                -(inverseB * this->tx + inverseD * this->ty)};
+        }
+
+        return decomposition;
+    }
+
+    Coefficients GetInverse_() const
+    {
+        auto decomposition = this->Decompose_();
+
+        if (!decomposition.isInvertible)
+        {
+            throw GraphicsError("GraphicsMatrix is not invertible");
+        }
+
+        return decomposition.inverse;
+    }
+
+    static void Transform_(
+        const Coefficients &m,
+        Point *points,
+        size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto x = points[i].x;
+            auto y = points[i].y;
+            points[i].x = m[0] * x + m[2] * y + m[4];
+            points[i].y = m[1] * x + m[3] * y + m[5];
+        }
+    }
 };
 
 
@@ -0,0 +1,420 @@
+#include "wxpex/histogram.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+#include "wxpex/color.h"
+
+
+namespace wxpex
+{
+
+
+uint64_t HistogramBins::GetNextSequence()
+{
+    static std::atomic<uint64_t> sequence{0};
+
+    return ++sequence;
+}
+
+
+uint32_t HistogramBins::GetMaximum() const
+{
+    if (this->counts.empty())
+    {
+        return 0;
+    }
+
+    return *std::max_element(this->counts.begin(), this->counts.end());
+}
+
+
+HistogramCounts::HistogramCounts(const HistogramSettings &settings)
+    :
+    windowSize_(settings.windowSize),
+    low_(0.0),
+    high_(1.0),
+    binCount_(1),
+    scale_(1.0),
+    window_(),
+    next_(0),
+    counts_(),
+    isStale_(true)
+{
+    if (settings.windowSize == 0)
+    {
+        throw std::invalid_argument("windowSize must be at least 1");
+    }
+
+    this->SetRange(settings.low, settings.high);
+    this->SetBinCount(settings.binCount);
+    this->window_.reserve(this->windowSize_);
+}
+
+
+void HistogramCounts::Append(const float *samples, size_t count)
+{
+    if (count >= this->windowSize_)
+    {
+        // The batch replaces the whole window, which is recounted when the
+        // bins are requested.
+        this->window_.assign(
+            samples + count - this->windowSize_,
+            samples + count);
+
+        this->next_ = 0;
+        this->isStale_ = true;
+
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto sample = samples[i];
+
+        if (this->window_.size() < this->windowSize_)
+        {
+            this->window_.push_back(sample);
+
+            if (!this->isStale_)
+            {
+                ++this->counts_[this->GetIndex_(sample)];
+            }
+
+            continue;
+        }
+
+        // The oldest sample leaves the window.
+        auto &oldest = this->window_[this->next_];
+
+        if (!this->isStale_)
+        {
+            --this->counts_[this->GetIndex_(oldest)];
+            ++this->counts_[this->GetIndex_(sample)];
+        }
+
+        oldest = sample;
+        this->next_ = (this->next_ + 1) % this->windowSize_;
+    }
+}
+
+
+void HistogramCounts::Append(const std::vector<float> &samples)
+{
+    this->Append(samples.data(), samples.size());
+}
+
+
+void HistogramCounts::Clear()
+{
+    this->window_.clear();
+    this->next_ = 0;
+    this->counts_.assign(this->binCount_ + 3, 0);
+    this->isStale_ = false;
+}
+
+
+void HistogramCounts::SetRange(double low, double high)
+{
+    if (!(low < high))
+    {
+        throw std::invalid_argument("low must be less than high");
+    }
+
+    if (low == this->low_ && high == this->high_)
+    {
+        return;
+    }
+
+    this->low_ = low;
+    this->high_ = high;
+    this->scale_ = static_cast<double>(this->binCount_) / (high - low);
+    this->isStale_ = true;
+}
+
+
+void HistogramCounts::SetBinCount(size_t binCount)
+{
+    if (binCount == 0)
+    {
+        throw std::invalid_argument("binCount must be at least 1");
+    }
+
+    if (binCount == this->binCount_)
+    {
+        return;
+    }
+
+    this->binCount_ = binCount;
+
+    this->scale_ =
+        static_cast<double>(binCount) / (this->high_ - this->low_);
+
+    this->isStale_ = true;
+}
+
+
+size_t HistogramCounts::GetWindowSize() const
+{
+    return this->windowSize_;
+}
+
+
+size_t HistogramCounts::GetCount() const
+{
+    return this->window_.size();
+}
+
+
+bool HistogramCounts::IsStale() const
+{
+    return this->isStale_;
+}
+
+
+HistogramBins HistogramCounts::GetBins()
+{
+    HistogramBins result;
+    this->GetBins(result);
+
+    return result;
+}
+
+
+void HistogramCounts::GetBins(HistogramBins &bins)
+{
+    if (this->isStale_)
+    {
+        this->Recount_();
+    }
+
+    auto first = this->counts_.begin() + 1;
+
+    bins.low = this->low_;
+    bins.high = this->high_;
+
+    bins.counts.assign(
+        first,
+        first + static_cast<std::ptrdiff_t>(this->binCount_));
+
+    bins.underflow = this->counts_[0];
+    bins.overflow = this->counts_[this->binCount_ + 1];
+    bins.ignored = this->counts_[this->binCount_ + 2];
+}
+
+
+size_t HistogramCounts::GetIndex_(float sample) const
+{
+    if (std::isnan(sample))
+    {
+        return this->binCount_ + 2;
+    }
+
+    auto position = (static_cast<double>(sample) - this->low_) * this->scale_;
+
+    if (position < 0.0)
+    {
+        return 0;
+    }
+
+    if (position >= static_cast<double>(this->binCount_))
+    {
+        return this->binCount_ + 1;
+    }
+
+    return static_cast<size_t>(position) + 1;
+}
+
+
+void HistogramCounts::Recount_()
+{
+    this->counts_.assign(this->binCount_ + 3, 0);
+
+    for (auto sample: this->window_)
+    {
+        ++this->counts_[this->GetIndex_(sample)];
+    }
+
+    this->isStale_ = false;
+}
+
+
+HistogramWriter::HistogramWriter(
+    HistogramControl workerControl,
+    const HistogramSettings &settings)
+    :
+    control_(workerControl),
+    mutex_(),
+    counts_(settings),
+    bins_()
+{
+
+}
+
+
+void HistogramWriter::Write(const std::vector<float> &samples)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->counts_.Append(samples);
+    }
+
+    this->Publish();
+}
+
+
+void HistogramWriter::SetRange(double low, double high)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->counts_.SetRange(low, high);
+}
+
+
+void HistogramWriter::SetBinCount(size_t binCount)
+{
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->counts_.SetBinCount(binCount);
+}
+
+
+void HistogramWriter::Publish()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->counts_.GetBins(this->bins_);
+    }
+
+    this->bins_.sequence = HistogramBins::GetNextSequence();
+    this->control_.Set(this->bins_);
+}
+
+
+Histogram::Histogram(
+    wxWindow *parent,
+    HistogramControl control,
+    const HistogramSettings &settings)
+    :
+    Canvas(parent, wxID_ANY),
+    settings_(settings),
+    endpoint_(this, control, &Histogram::OnBins_),
+    bins_(control.Get()),
+    maximum_(this->bins_.GetMaximum())
+{
+
+}
+
+
+const HistogramBins & Histogram::GetBins() const
+{
+    return this->bins_;
+}
+
+
+wxSize Histogram::DoGetBestClientSize() const
+{
+    return wxSize(300, 150);
+}
+
+
+void Histogram::OnBins_(pex::Argument<HistogramBins> bins)
+{
+    auto maximum = bins.GetMaximum();
+
+    if (
+        maximum != this->maximum_
+        || bins.counts.size() != this->bins_.counts.size())
+    {
+        // Every bar changes scale or position.
+        this->bins_ = bins;
+        this->maximum_ = maximum;
+        this->Refresh(false);
+
+        return;
+    }
+
+    auto mismatch = std::mismatch(
+        bins.counts.begin(),
+        bins.counts.end(),
+        this->bins_.counts.begin());
+
+    if (mismatch.first == bins.counts.end())
+    {
+        this->bins_ = bins;
+
+        return;
+    }
+
+    auto last = std::mismatch(
+        bins.counts.rbegin(),
+        bins.counts.rend(),
+        this->bins_.counts.rbegin());
+
+    auto first = static_cast<size_t>(mismatch.first - bins.counts.begin());
+    auto end = static_cast<size_t>(bins.counts.rend() - last.first);
+
+    this->bins_ = bins;
+
+    auto left = this->GetBarEdge_(first);
+    auto right = this->GetBarEdge_(end);
+    auto height = this->GetClientSize().GetHeight();
+
+    this->RefreshRect(wxRect(left, 0, right - left, height), false);
+}
+
+
+void Histogram::DrawCanvas_(GraphicsContext &context, const wxRect &stale)
+{
+    if (this->maximum_ == 0)
+    {
+        return;
+    }
+
+    auto height = static_cast<double>(this->GetClientSize().GetHeight());
+    auto scale = height / static_cast<double>(this->maximum_);
+    auto path = context->CreatePath();
+
+    for (size_t index = 0; index < this->bins_.counts.size(); ++index)
+    {
+        auto left = this->GetBarEdge_(index);
+        auto right = this->GetBarEdge_(index + 1);
+
+        if (right <= stale.GetLeft() || left > stale.GetRight())
+        {
+            continue;
+        }
+
+        // Leave a gap between bars that are wide enough to spare it.
+        auto width = right - left;
+
+        if (width >= 4)
+        {
+            --width;
+        }
+
+        auto barHeight = scale * static_cast<double>(this->bins_.counts[index]);
+
+        path.AddRectangle(
+            static_cast<double>(left),
+            height - barHeight,
+            static_cast<double>(width),
+            barHeight);
+    }
+
+    context->SetPen(wxNullPen);
+    context->SetBrush(wxBrush(ToWxColour(this->settings_.color)));
+    context->FillPath(path);
+}
+
+
+int Histogram::GetBarEdge_(size_t index) const
+{
+    auto count = std::max<size_t>(this->bins_.counts.size(), 1);
+    auto width = static_cast<size_t>(this->GetClientSize().GetWidth());
+
+    return static_cast<int>(index * width / count);
+}
+
+
+} // end namespace wxpex
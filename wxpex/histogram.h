@@ -0,0 +1,253 @@
+#pragma once
+
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <tau/color.h>
+#include <pex/endpoint.h>
+
+#include "wxpex/async.h"
+#include "wxpex/canvas.h"
+
+
+namespace wxpex
+{
+
+
+class HistogramSettings
+{
+public:
+    using Rgb = tau::Rgb<uint8_t>;
+
+    static constexpr size_t defaultBinCount = 64;
+    static constexpr size_t defaultWindowSize = size_t(1) << 16;
+
+    HistogramSettings()
+        :
+        binCount(defaultBinCount),
+        low(0.0),
+        high(1.0),
+        windowSize(defaultWindowSize),
+        color{{0, 160, 255}}
+    {
+
+    }
+
+    // All setting functions return a reference to this instance so they can be
+    // chained.
+    //
+    // settings.BinCount(100).Range(-5.0, 5.0).WindowSize(10'000);
+
+    HistogramSettings & BinCount(size_t value)
+    {
+        this->binCount = value;
+        return *this;
+    }
+
+    // Samples from low up to, but not including, high are counted in bins.
+    HistogramSettings & Range(double low_, double high_)
+    {
+        this->low = low_;
+        this->high = high_;
+        return *this;
+    }
+
+    // The number of most recent samples that are counted.
+    HistogramSettings & WindowSize(size_t value)
+    {
+        this->windowSize = value;
+        return *this;
+    }
+
+    HistogramSettings & Color(const Rgb &value)
+    {
+        this->color = value;
+        return *this;
+    }
+
+    size_t binCount;
+    double low;
+    double high;
+    size_t windowSize;
+    Rgb color;
+};
+
+
+/**
+ ** The counts of a HistogramCounts, as published to a Histogram.
+ **
+ ** Bins compare equal by sequence alone, so Async does not compare every
+ ** count.
+ **/
+struct HistogramBins
+{
+    uint64_t sequence = 0;
+    double low = 0.0;
+    double high = 1.0;
+    std::vector<uint32_t> counts;
+
+    // Samples below low, at or above high, and NaN.
+    uint32_t underflow = 0;
+    uint32_t overflow = 0;
+    uint32_t ignored = 0;
+
+    bool operator==(const HistogramBins &other) const
+    {
+        return this->sequence == other.sequence;
+    }
+
+    /**
+     ** Sequences are unique within the process, starting from 1, so bins
+     ** never equal ones sent earlier, even by another writer.
+     **
+     ** May be called from any thread.
+     **/
+    static uint64_t GetNextSequence();
+
+    uint32_t GetMaximum() const;
+};
+
+
+/**
+ ** Counts the most recent windowSize samples of a stream in bins.
+ **
+ ** Each sample is counted as it arrives, and uncounted as it leaves the
+ ** window, so the cost of a batch does not depend on the size of the window.
+ **
+ ** Changing the range or the number of bins only marks the counts as stale.
+ ** They are recounted from the window once, when they are next requested,
+ ** however many batches arrive in between.
+ **/
+class HistogramCounts
+{
+public:
+    HistogramCounts(const HistogramSettings &settings = HistogramSettings());
+
+    void Append(const float *samples, size_t count);
+
+    void Append(const std::vector<float> &samples);
+
+    void Clear();
+
+    // Throws std::invalid_argument unless low is less than high.
+    void SetRange(double low, double high);
+
+    // Throws std::invalid_argument if binCount is 0.
+    void SetBinCount(size_t binCount);
+
+    size_t GetWindowSize() const;
+
+    // The number of samples in the window.
+    size_t GetCount() const;
+
+    // True if the range or bin count changed since the last recount.
+    bool IsStale() const;
+
+    // Recounts the window if it is stale.
+    HistogramBins GetBins();
+
+    // Fills bins without reallocating its counts.
+    void GetBins(HistogramBins &bins);
+
+private:
+    size_t GetIndex_(float sample) const;
+
+    void Recount_();
+
+    size_t windowSize_;
+    double low_;
+    double high_;
+    size_t binCount_;
+    double scale_;
+
+    // A ring buffer of the samples in the window.
+    std::vector<float> window_;
+    size_t next_;
+
+    // Underflow, then the bins, then overflow and NaN.
+    std::vector<uint32_t> counts_;
+    bool isStale_;
+};
+
+
+using HistogramAsync = Async<HistogramBins>;
+using HistogramControl = typename HistogramAsync::Control;
+
+
+/**
+ ** Counts samples on a worker thread, and sends the bins through the worker
+ ** control of a HistogramAsync to a Histogram connected to its wx control.
+ **
+ ** Only the bins cross threads, so the cost of delivery depends on the number
+ ** of bins and not on the number of samples.
+ **
+ ** Write and Publish must be called from the worker thread. SetRange and
+ ** SetBinCount may be called from any thread, like the wx event loop thread
+ ** responding to a control.
+ **/
+class HistogramWriter
+{
+public:
+    HistogramWriter(
+        HistogramControl workerControl,
+        const HistogramSettings &settings = HistogramSettings());
+
+    // Counts samples, and publishes the bins.
+    void Write(const std::vector<float> &samples);
+
+    // Takes effect with the next Write or Publish.
+    void SetRange(double low, double high);
+
+    void SetBinCount(size_t binCount);
+
+    void Publish();
+
+private:
+    HistogramControl control_;
+
+    // Guards counts_, which SetRange and SetBinCount may change from
+    // another thread.
+    std::mutex mutex_;
+    HistogramCounts counts_;
+    HistogramBins bins_;
+};
+
+
+/**
+ ** Draws the bins published by a HistogramWriter as bars, scaled to the
+ ** largest bin.
+ **
+ ** When the largest bin and the number of bins are unchanged, only the bars
+ ** from the first to the last changed bin are redrawn.
+ **/
+class Histogram: public Canvas
+{
+public:
+    static constexpr auto observerName = "wxpex::Histogram";
+
+    Histogram(
+        wxWindow *parent,
+        HistogramControl control,
+        const HistogramSettings &settings = HistogramSettings());
+
+    const HistogramBins & GetBins() const;
+
+    wxSize DoGetBestClientSize() const override;
+
+private:
+    void OnBins_(pex::Argument<HistogramBins> bins);
+
+    void DrawCanvas_(GraphicsContext &context, const wxRect &stale) override;
+
+    // The left edge of bar index, in pixels.
+    int GetBarEdge_(size_t index) const;
+
+    HistogramSettings settings_;
+    pex::Endpoint<Histogram, HistogramControl> endpoint_;
+    HistogramBins bins_;
+    uint32_t maximum_;
+};
+
+
+} // end namespace wxpex
@@ -0,0 +1,214 @@
+#include "wxpex/image_view.h"
+
+#include <algorithm>
+
+#include "wxpex/ignores.h"
+#include "wxpex/paint_profiler.h"
+
+WXSHIM_PUSH_IGNORES
+#include <wx/dcbuffer.h>
+#include <wx/rawbmp.h>
+WXSHIM_POP_IGNORES
+
+
+namespace wxpex
+{
+
+
+ImageView::ImageView(
+    wxWindow *parent,
+    std::shared_ptr<ImageSlot> slot,
+    const ImageViewSettings &settings)
+    :
+    wxPanel(parent, wxID_ANY),
+    slot_(slot),
+    settings_(settings),
+    timer_(this),
+    bitmap_(),
+    isBitmapStale_(false)
+{
+    if (!this->slot_)
+    {
+        throw std::invalid_argument("ImageView requires an ImageSlot");
+    }
+
+    // Every pixel is painted in OnPaint_.
+    this->SetBackgroundStyle(wxBG_STYLE_PAINT);
+
+    this->Bind(wxEVT_PAINT, &ImageView::OnPaint_, this);
+    this->Bind(wxEVT_SIZE, &ImageView::OnSize_, this);
+    this->Bind(wxEVT_TIMER, &ImageView::OnTimer_, this);
+
+    this->timer_.Start(this->settings_.pollInterval_ms);
+}
+
+
+void ImageView::SetInterpolation(Interpolation interpolation)
+{
+    if (interpolation == this->settings_.interpolation)
+    {
+        return;
+    }
+
+    this->settings_.interpolation = interpolation;
+    this->Refresh(false);
+}
+
+
+Interpolation ImageView::GetInterpolation() const
+{
+    return this->settings_.interpolation;
+}
+
+
+const std::shared_ptr<ImageSlot> & ImageView::GetSlot() const
+{
+    return this->slot_;
+}
+
+
+wxSize ImageView::DoGetBestClientSize() const
+{
+    const auto &frame = this->slot_->GetReadBuffer();
+
+    if (frame.IsEmpty())
+    {
+        return wxSize(320, 240);
+    }
+
+    return wxSize(frame.width, frame.height);
+}
+
+
+void ImageView::OnTimer_(wxTimerEvent &)
+{
+    if (!this->slot_->Acquire())
+    {
+        return;
+    }
+
+    this->isBitmapStale_ = true;
+    this->Refresh(false);
+}
+
+
+void ImageView::OnPaint_(wxPaintEvent &)
+{
+    PROFILE_PAINT(this)
+
+    wxAutoBufferedPaintDC dc(this);
+
+    dc.SetBackground(wxBrush(this->GetBackgroundColour()));
+    dc.Clear();
+
+    auto &frame = this->slot_->GetReadBuffer();
+
+    if (frame.IsEmpty())
+    {
+        return;
+    }
+
+    if (this->isBitmapStale_ || !this->bitmap_.IsOk())
+    {
+        this->UpdateBitmap_(frame);
+        this->isBitmapStale_ = false;
+    }
+
+    GraphicsContext context(dc);
+
+    context.SetInterpolation(this->settings_.interpolation);
+
+    auto target = this->GetTarget_(frame);
+
+    context->DrawBitmap(
+        this->bitmap_,
+        target.m_x,
+        target.m_y,
+        target.m_width,
+        target.m_height);
+
+    PROFILE_PAINT_OVERLAY(context, this)
+}
+
+
+void ImageView::OnSize_(wxSizeEvent &event)
+{
+    // The frame is rescaled to the new size.
+    this->Refresh(false);
+    event.Skip();
+}
+
+
+wxRect2DDouble ImageView::GetTarget_(const ImageFrame &frame) const
+{
+    auto client = this->GetClientSize();
+    auto clientWidth = static_cast<double>(client.GetWidth());
+    auto clientHeight = static_cast<double>(client.GetHeight());
+
+    if (!this->settings_.preserveAspectRatio)
+    {
+        return wxRect2DDouble(0.0, 0.0, clientWidth, clientHeight);
+    }
+
+    auto scale = std::min(
+        clientWidth / static_cast<double>(frame.width),
+        clientHeight / static_cast<double>(frame.height));
+
+    auto width = scale * static_cast<double>(frame.width);
+    auto height = scale * static_cast<double>(frame.height);
+
+    // Centered, with the remainder showing the background.
+    return wxRect2DDouble(
+        (clientWidth - width) / 2.0,
+        (clientHeight - height) / 2.0,
+        width,
+        height);
+}
+
+
+void ImageView::UpdateBitmap_(const ImageFrame &frame)
+{
+    if (
+        !this->bitmap_.IsOk()
+        || this->bitmap_.GetWidth() != frame.width
+        || this->bitmap_.GetHeight() != frame.height)
+    {
+        this->bitmap_ = wxBitmap(frame.width, frame.height, 24);
+    }
+
+    wxNativePixelData data(this->bitmap_);
+
+    if (!data)
+    {
+        // The platform does not expose the pixels of this bitmap.
+        this->bitmap_ = wxBitmap(
+            wxImage(
+                frame.width,
+                frame.height,
+                const_cast<unsigned char *>(frame.rgb.data()),
+                true));
+
+        return;
+    }
+
+    auto source = frame.rgb.data();
+    wxNativePixelData::Iterator row(data);
+
+    for (int y = 0; y < frame.height; ++y)
+    {
+        auto pixel = row;
+
+        for (int x = 0; x < frame.width; ++x)
+        {
+            pixel.Red() = *source++;
+            pixel.Green() = *source++;
+            pixel.Blue() = *source++;
+            ++pixel;
+        }
+
+        row.OffsetY(data, 1);
+    }
+}
+
+
+} // end namespace wxpex
@@ -0,0 +1,106 @@
+#pragma once
+
+
+#include <memory>
+
+#include "wxpex/wxshim.h"
+#include "wxpex/graphics.h"
+#include "wxpex/frame_slot.h"
+
+
+namespace wxpex
+{
+
+
+class ImageViewSettings
+{
+public:
+    static constexpr int defaultPollInterval_ms = 16;
+
+    ImageViewSettings()
+        :
+        pollInterval_ms(defaultPollInterval_ms),
+        interpolation(wxpex::Interpolation::DEFAULT),
+        preserveAspectRatio(true)
+    {
+
+    }
+
+    // All setting functions return a reference to this instance so they can be
+    // chained.
+    //
+    // settings.PollInterval_ms(8).Interpolation(Interpolation::none);
+
+    // How often to check the slot for a new frame.
+    ImageViewSettings & PollInterval_ms(int value)
+    {
+        this->pollInterval_ms = value;
+        return *this;
+    }
+
+    ImageViewSettings & Interpolation(wxpex::Interpolation value)
+    {
+        this->interpolation = value;
+        return *this;
+    }
+
+    ImageViewSettings & PreserveAspectRatio(bool value)
+    {
+        this->preserveAspectRatio = value;
+        return *this;
+    }
+
+    int pollInterval_ms;
+    wxpex::Interpolation interpolation;
+    bool preserveAspectRatio;
+};
+
+
+/**
+ ** Displays the newest frame published to an ImageSlot by a worker thread,
+ ** scaled to fit the window.
+ **
+ ** The worker fills slot->GetWriteBuffer() and calls slot->Publish(), and
+ ** never waits on the view. The view checks the slot on a timer, and only
+ ** repaints when a new frame has arrived. Each frame is copied directly into
+ ** the pixels of a native bitmap, which is only reallocated when the frame
+ ** size changes.
+ **/
+class ImageView: public wxPanel
+{
+public:
+    ImageView(
+        wxWindow *parent,
+        std::shared_ptr<ImageSlot> slot,
+        const ImageViewSettings &settings = ImageViewSettings());
+
+    void SetInterpolation(Interpolation interpolation);
+
+    Interpolation GetInterpolation() const;
+
+    const std::shared_ptr<ImageSlot> & GetSlot() const;
+
+    wxSize DoGetBestClientSize() const override;
+
+private:
+    void OnTimer_(wxTimerEvent &);
+
+    void OnPaint_(wxPaintEvent &);
+
+    void OnSize_(wxSizeEvent &);
+
+    // The area of the client that the frame is scaled into.
+    wxRect2DDouble GetTarget_(const ImageFrame &frame) const;
+
+    // Copies the pixels of frame into bitmap_.
+    void UpdateBitmap_(const ImageFrame &frame);
+
+    std::shared_ptr<ImageSlot> slot_;
+    ImageViewSettings settings_;
+    wxTimer timer_;
+    wxBitmap bitmap_;
+    bool isBitmapStale_;
+};
+
+
+} // end namespace wxpex
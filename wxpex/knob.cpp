@@ -1,10 +1,264 @@
 #include "wxpex/knob.h"
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+#include "wxpex/resource_cache.h"
+
 
 namespace wxpex
 {
 
 
+namespace
+{
+
+
+using BodyCache = std::map<KnobBody::Key, std::weak_ptr<const KnobBody>>;
+
+
+BodyCache & GetBodyCache()
+{
+    static BodyCache bodyCache;
+
+    return bodyCache;
+}
+
+
+void PruneBodyCache(BodyCache &bodyCache)
+{
+    for (auto it = bodyCache.begin(); it != bodyCache.end();)
+    {
+        if (it->second.expired())
+        {
+            it = bodyCache.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+
+auto AsTuple(const KnobBody::Key &key)
+{
+    return std::make_tuple(
+        key.radius,
+        key.color.red,
+        key.color.green,
+        key.color.blue,
+        key.scale);
+}
+
+
+} // end anonymous namespace
+
+
+bool KnobBody::Key::operator<(const Key &other) const
+{
+    return AsTuple(*this) < AsTuple(other);
+}
+
+
+bool KnobBody::Key::operator==(const Key &other) const
+{
+    return AsTuple(*this) == AsTuple(other);
+}
+
+
+KnobBody::KnobBody(const Key &key)
+    :
+    key_(key),
+    bitmap_()
+{
+    auto side = static_cast<double>(this->GetSide());
+    auto pixels = static_cast<int>(std::ceil(side * key.scale));
+
+    // Start fully transparent, so the body can be drawn over any background.
+    wxImage image(pixels, pixels);
+    image.InitAlpha();
+    std::fill_n(image.GetAlpha(), pixels * pixels, 0);
+
+    {
+        GraphicsContext graphicsContext(image);
+        graphicsContext->Scale(key.scale, key.scale);
+
+        DrawKnobBody(
+            graphicsContext,
+            tau::Point2d<double>(side / 2.0, side / 2.0),
+            key.radius,
+            key.color);
+
+        // The image is updated when the context is destroyed.
+    }
+
+    this->bitmap_ = wxBitmap(image);
+}
+
+
+std::shared_ptr<const KnobBody> KnobBody::Acquire(const Key &key)
+{
+    auto &bodyCache = GetBodyCache();
+    auto &weak = bodyCache[key];
+    auto result = weak.lock();
+
+    if (result)
+    {
+        return result;
+    }
+
+    result = std::make_shared<const KnobBody>(key);
+    weak = result;
+
+    // Forget bodies that are no longer used by any knob.
+    PruneBodyCache(bodyCache);
+
+    return result;
+}
+
+
+size_t KnobBody::GetCacheSize()
+{
+    auto &bodyCache = GetBodyCache();
+    PruneBodyCache(bodyCache);
+
+    return bodyCache.size();
+}
+
+
+const KnobBody::Key & KnobBody::GetKey() const
+{
+    return this->key_;
+}
+
+
+int KnobBody::GetSide() const
+{
+    return static_cast<int>(this->key_.radius * 2 + 2);
+}
+
+
+const wxBitmap & KnobBody::GetBitmap() const
+{
+    return this->bitmap_;
+}
+
+
+KnobIndicator GetKnobIndicator(
+    const tau::Point2d<double> &center,
+    double radius,
+    double angle)
+{
+    auto radians = tau::ToRadians(angle);
+
+    auto indicatorVector = tau::Point2d<double>(
+        std::cos(radians),
+        std::sin(radians));
+
+    return {
+        center + indicatorVector * 0.66 * radius,
+        center + indicatorVector * radius};
+}
+
+
+void DrawKnobBody(
+    GraphicsContext &context,
+    const tau::Point2d<double> &center,
+    unsigned radius,
+    const KnobSettings::Rgb &color)
+{
+    auto settings = KnobSettings().Radius(radius).Color(color);
+    auto bodyRadius = static_cast<double>(radius);
+    auto offset = bodyRadius / 4;
+
+    // Draw gradient.
+    context->SetBrush(
+        context->CreateRadialGradientBrush(
+            center.x - offset,
+            center.y - offset,
+            center.x,
+            center.y,
+            bodyRadius,
+            settings.GetHighlightColor(),
+            settings.GetBaseColor()));
+
+    context->SetPen(
+        context->CreatePen(
+            wxGraphicsPenInfo(settings.GetOutlineColor(), 1.0)));
+
+    context->DrawEllipse(
+        center.x - bodyRadius,
+        center.y - bodyRadius,
+        bodyRadius * 2,
+        bodyRadius * 2);
+}
+
+
+void StrokeKnobIndicator(
+    GraphicsContext &context,
+    const tau::Point2d<double> &center,
+    double radius,
+    double angle)
+{
+    auto [indicatorBegin, indicatorEnd] =
+        GetKnobIndicator(center, radius, angle);
+
+    context->StrokeLine(
+        indicatorBegin.x,
+        indicatorBegin.y,
+        indicatorEnd.x,
+        indicatorEnd.y);
+}
+
+
+void DrawKnob(
+    GraphicsContext &context,
+    const KnobBody &body,
+    const tau::Point2d<double> &center,
+    double radius,
+    const wxColour &outline,
+    double angle)
+{
+    // Draw the cached body, centered.
+    auto side = static_cast<double>(body.GetSide());
+
+    context->DrawBitmap(
+        body.GetBitmap(),
+        center.x - side / 2.0,
+        center.y - side / 2.0,
+        side,
+        side);
+
+    // Draw indicator.
+    context->SetPen(
+        GraphicsResourceCache::Get(context).GetPen(
+            outline,
+            knobIndicatorWidth));
+
+    StrokeKnobIndicator(context, center, radius, angle);
+}
+
+
+const KnobBody & KnobBase::GetBody_()
+{
+    auto key = KnobBody::Key{
+        this->settings_.radius,
+        this->settings_.color,
+        this->GetContentScaleFactor()};
+
+    if (!this->body_ || !(this->body_->GetKey() == key))
+    {
+        // The color or the display's scale factor has changed.
+        this->body_ = KnobBody::Acquire(key);
+    }
+
+    return *this->body_;
+}
+
+
 std::unique_ptr<wxBoxSizer> MakeSizer(
     const KnobSettings &knobSettings,
     wxWindow *knob,
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <memory>
 #include <tau/angles.h>
 #include <pex/range.h>
 #include <pex/converter.h>
@@ -16,13 +18,9 @@
 #include "wxpex/color.h"
 #include "wxpex/graphics.h"
 #include "wxpex/style.h"
-
-
-#ifdef __WXMSW__
-WXSHIM_PUSH_IGNORES
-#include <wx/dcbuffer.h>
-WXSHIM_POP_IGNORES
-#endif // __WXMSW__
+#include "wxpex/damage.h"
+#include "wxpex/startup_profiler.h"
+#include "wxpex/canvas.h"
 
 
 namespace wxpex
@@ -183,18 +181,122 @@ public:
 };
 
 
-class KnobBase: public wxWindow
+/**
+ ** The gradient-filled circle of a knob, rendered once into a bitmap that is
+ ** shared by every knob with the same radius, color, and scale factor.
+ **
+ ** Only the indicator changes with the value of a knob, so painting a knob
+ ** only draws this bitmap and strokes the indicator.
+ **
+ ** Must only be used from the wx event loop thread.
+ **/
+class KnobBody
+{
+public:
+    using Rgb = typename KnobSettings::Rgb;
+
+    struct Key
+    {
+        unsigned radius;
+        Rgb color;
+        double scale;
+
+        bool operator<(const Key &other) const;
+        bool operator==(const Key &other) const;
+    };
+
+    KnobBody(const Key &key);
+
+    /**
+     ** Returns the body for key from the shared cache, rendering it if no
+     ** knob is using it already.
+     **/
+    static std::shared_ptr<const KnobBody> Acquire(const Key &key);
+
+    // The number of bodies currently in use.
+    static size_t GetCacheSize();
+
+    const Key & GetKey() const;
+
+    // The side of the square body in logical (unscaled) pixels.
+    int GetSide() const;
+
+    // Rendered at the scale factor of the key.
+    const wxBitmap & GetBitmap() const;
+
+private:
+    Key key_;
+    wxBitmap bitmap_;
+};
+
+
+static constexpr int knobIndicatorWidth = 2;
+
+using KnobIndicator = std::array<tau::Point2d<double>, 2>;
+
+
+/**
+ ** The indicator line runs from two thirds of the radius to the edge.
+ **
+ ** @param angle In degrees, clockwise from the positive x axis.
+ **/
+KnobIndicator GetKnobIndicator(
+    const tau::Point2d<double> &center,
+    double radius,
+    double angle);
+
+
+/**
+ ** Draws the gradient-filled circle of a knob directly, without a bitmap.
+ **
+ ** KnobBody renders its bitmap with this function. It can also be used where
+ ** wxBitmap is not allowed, like the tiles drawn by RenderOffscreen.
+ **/
+void DrawKnobBody(
+    GraphicsContext &context,
+    const tau::Point2d<double> &center,
+    unsigned radius,
+    const KnobSettings::Rgb &color);
+
+
+// Strokes the indicator at angle with the current pen.
+void StrokeKnobIndicator(
+    GraphicsContext &context,
+    const tau::Point2d<double> &center,
+    double radius,
+    double angle);
+
+
+/**
+ ** Draws body centered on center, and strokes the indicator at angle.
+ **
+ ** Knob paints itself with this function. It uses the bitmap of body and the
+ ** shared GraphicsResourceCache, so it must only be called from the wx event
+ ** loop thread.
+ **/
+void DrawKnob(
+    GraphicsContext &context,
+    const KnobBody &body,
+    const tau::Point2d<double> &center,
+    double radius,
+    const wxColour &outline,
+    double angle);
+
+
+class KnobBase: public Canvas
 {
 public:
     using Rgb = typename KnobSettings::Rgb;
 
     KnobBase(wxWindow *parent, const KnobSettings &settings)
         :
-        wxWindow(parent, wxID_ANY),
+        Canvas(parent, wxID_ANY),
         settings_(settings),
         color_(settings.GetBaseColor()),
         highlight_(settings.GetHighlightColor()),
-        outline_(settings.GetOutlineColor())
+        outline_(settings.GetOutlineColor()),
+        damage_(this),
+        body_()
     {
 
     }
@@ -210,7 +312,12 @@ public:
         this->color_ = this->settings_.GetBaseColor();
         this->highlight_ = this->settings_.GetHighlightColor();
         this->outline_ = this->settings_.GetOutlineColor();
-        this->Refresh();
+
+        // The body will be acquired for the new color on the next paint.
+        this->body_.reset();
+
+        this->damage_.Add(this->GetBodyRegion_());
+        this->damage_.Refresh();
     }
 
     void SetColor(const tau::Hsv<double> &hsv)
@@ -233,11 +340,53 @@ public:
 
 
 protected:
+    // Returns the cached body for the current color and scale factor.
+    const KnobBody & GetBody_();
+
+    tau::Point2d<double> GetCenter_() const
+    {
+        return (ToSize<double>(this->GetClientSize()) / 2).ToPoint2d();
+    }
+
+    /**
+     ** Before Knob was a Canvas, GTK and macOS drew the system background
+     ** behind it, which shows the parent. Match the parent unless a
+     ** background color has been set on the knob.
+     **/
+    wxColour GetCanvasBackground_() const override
+    {
+#ifndef __WXMSW__
+        auto parent = this->GetParent();
+
+        if (parent && !this->UseBgCol())
+        {
+            return parent->GetBackgroundColour();
+        }
+#endif
+
+        return this->GetBackgroundColour();
+    }
+
+    // The area covered by the body, which includes the indicator.
+    tau::Region<double> GetBodyRegion_() const
+    {
+        auto halfSide = static_cast<double>(this->settings_.radius) + 1.0;
+        auto side = 2.0 * halfSide;
+
+        return {{
+            this->GetCenter_() - halfSide,
+            tau::Size<double>(side, side)}};
+    }
+
     KnobSettings settings_;
 
     wxColour color_;
     wxColour highlight_;
     wxColour outline_;
+    DamageTracker damage_;
+
+private:
+    std::shared_ptr<const KnobBody> body_;
 };
 
 
@@ -287,14 +436,9 @@ public:
             static_cast<double>(this->maximum_.Get() - this->minimum_.Get())),
         valueOffset_(-static_cast<double>(this->minimum_.Get())),
         hasCapturedMouse_(false),
-        mousePosition_()
+        mousePosition_(),
+        paintedAngle_(this->GetAngle_())
     {
-#ifdef __WXMSW__
-        this->SetBackgroundStyle(wxBG_STYLE_PAINT);
-#else
-        this->SetBackgroundStyle(wxBG_STYLE_SYSTEM);
-#endif
-        this->Bind(wxEVT_PAINT, &Knob::OnPaint_, this);
         this->Bind(wxEVT_LEFT_DOWN, &Knob::OnMouseEvents_, this);
         this->Bind(wxEVT_MOTION, &Knob::OnMouseEvents_, this);
         this->Bind(wxEVT_LEFT_UP, &Knob::OnMouseEvents_, this);
@@ -302,6 +446,9 @@ public:
 #ifdef _WIN32
         this->Bind(wxEVT_MOUSE_CAPTURE_LOST, &Knob::OnMouseCaptureLost_, this);
 #endif
+
+        // value_, minimum_, and maximum_ were connected on construction.
+        PROFILE_WIDGET_CONNECTED(this)
     }
 
     wxSize DoGetBestClientSize() const override
@@ -328,7 +475,11 @@ private:
             this->localValue_ = value;
         }
 
-        this->Refresh();
+        // Only the indicator moves. Redraw it where it was last painted, and
+        // where it will be painted next.
+        this->damage_.Add(this->GetIndicatorRegion_(this->paintedAngle_));
+        this->damage_.Add(this->GetIndicatorRegion_(this->GetAngle_()));
+        this->damage_.Refresh();
     }
 
     void OnMinimum_(Type minimum)
@@ -370,74 +521,41 @@ private:
         return this->startAngle_ + (scaled * this->angleRange_) - 90.0;
     }
 
-    void OnPaint_(wxPaintEvent &)
-    {
-#ifdef __WXMSW__
-        wxBufferedPaintDC dc(this);
-#else
-        wxPaintDC dc(this);
-#endif
-
-        auto size = ToSize<double>(this->GetClientSize());
-
-        auto center = (size / 2).ToPoint2d();
-        auto gradientOffset = center;
-        auto radius = double(this->radius_);
-        auto offset = radius / 4;
-
-        gradientOffset.x -= offset;
-        gradientOffset.y -= offset;
-        auto gradientBegin = ToWxPoint(gradientOffset);
-        auto gradientEnd = ToWxPoint(center);
-
-#ifdef __WXMSW__
-        auto backgroundColor = this->GetBackgroundColour();
-        dc.SetBrush(wxBrush(backgroundColor));
-        dc.DrawRectangle(wxPoint(0, 0), ToWxSize(size));
-#endif
-
-        GraphicsContext graphicsContext(dc);
+    static constexpr int indicatorWidth = knobIndicatorWidth;
 
-        // Draw gradient.
-        graphicsContext->SetBrush(
-            graphicsContext->CreateRadialGradientBrush(
-                gradientBegin.x,
-                gradientBegin.y,
-                gradientEnd.x,
-                gradientEnd.y,
-                radius,
-                this->highlight_,
-                this->color_));
-
-        auto circleBegin = center - radius;
-
-        graphicsContext->SetPen(
-            graphicsContext->CreatePen(wxPen(this->outline_, 1)));
+    KnobIndicator GetIndicator_(double angle) const
+    {
+        return GetKnobIndicator(this->GetCenter_(), this->radius_, angle);
+    }
 
-        graphicsContext->DrawEllipse(
-            circleBegin.x,
-            circleBegin.y,
-            int(radius * 2),
-            int(radius * 2));
+    tau::Region<double> GetIndicatorRegion_(double angle) const
+    {
+        auto [begin, end] = this->GetIndicator_(angle);
 
-        // Draw indicator.
-        graphicsContext->SetPen(
-            graphicsContext->CreatePen(wxPen(this->outline_, 2)));
+        // Half the pen width, and one pixel for antialiasing.
+        auto margin = indicatorWidth / 2.0 + 1.0;
 
-        auto indicatorAngle = tau::ToRadians(this->GetAngle_());
+        auto left = std::min(begin.x, end.x) - margin;
+        auto top = std::min(begin.y, end.y) - margin;
+        auto right = std::max(begin.x, end.x) + margin;
+        auto bottom = std::max(begin.y, end.y) + margin;
 
-        auto indicatorVector = tau::Point2d<double>(
-            std::cos(indicatorAngle),
-            std::sin(indicatorAngle));
+        return {{
+            tau::Point2d<double>(left, top),
+            tau::Size<double>(right - left, bottom - top)}};
+    }
 
-        auto indicatorBegin = center + indicatorVector * 0.66 * radius;
-        auto indicatorEnd = center + indicatorVector * radius;
+    void DrawCanvas_(GraphicsContext &context, const wxRect &) override
+    {
+        this->paintedAngle_ = this->GetAngle_();
 
-        graphicsContext->StrokeLine(
-            indicatorBegin.x,
-            indicatorBegin.y,
-            indicatorEnd.x,
-            indicatorEnd.y);
+        DrawKnob(
+            context,
+            this->GetBody_(),
+            this->GetCenter_(),
+            this->radius_,
+            this->outline_,
+            this->paintedAngle_);
     }
 
     void OnMouseEvents_(wxMouseEvent &mouseEvent)
@@ -569,6 +687,7 @@ private:
     double valueOffset_;
     bool hasCapturedMouse_;
     tau::Point2d<int> mousePosition_;
+    double paintedAngle_;
 };
 
 
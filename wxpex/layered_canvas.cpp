@@ -0,0 +1,228 @@
+#include "wxpex/layered_canvas.h"
+
+#include "wxpex/ignores.h"
+#include "wxpex/offscreen.h"
+
+WXSHIM_PUSH_IGNORES
+#include <wx/dcmemory.h>
+WXSHIM_POP_IGNORES
+
+
+namespace wxpex
+{
+
+
+LayeredCanvas::LayeredCanvas(wxWindow *parent, wxWindowID id)
+    :
+    Canvas(parent, id),
+    layers_()
+{
+
+}
+
+
+size_t LayeredCanvas::AddLayer(
+    const DrawLayer &drawLayer,
+    const LayerSettings &settings)
+{
+    // The tiles are allocated, and the whole layer drawn, on the next paint.
+    this->layers_.push_back({drawLayer, settings, {}, {}, 0.0, {}});
+    this->Refresh(false);
+
+    return this->layers_.size() - 1;
+}
+
+
+size_t LayeredCanvas::GetLayerCount() const
+{
+    return this->layers_.size();
+}
+
+
+void LayeredCanvas::InvalidateLayer(size_t index)
+{
+    this->InvalidateLayer(index, wxRect(this->GetBackingSize()));
+}
+
+
+void LayeredCanvas::InvalidateLayer(size_t index, const wxRect &rect)
+{
+    auto &layer = this->layers_.at(index);
+    AddStaleRect(layer.stale, rect);
+
+    if (layer.settings.isVisible)
+    {
+        this->RefreshRect(rect, false);
+    }
+}
+
+
+void LayeredCanvas::SetComposition(size_t index, Composition composition)
+{
+    auto &layer = this->layers_.at(index);
+
+    if (composition == layer.settings.composition)
+    {
+        return;
+    }
+
+    layer.settings.composition = composition;
+
+    if (layer.settings.isVisible)
+    {
+        this->Refresh(false);
+    }
+}
+
+
+void LayeredCanvas::SetVisible(size_t index, bool isVisible)
+{
+    auto &layer = this->layers_.at(index);
+
+    if (isVisible == layer.settings.isVisible)
+    {
+        return;
+    }
+
+    layer.settings.isVisible = isVisible;
+    this->Refresh(false);
+}
+
+
+const LayerSettings & LayeredCanvas::GetLayerSettings(size_t index) const
+{
+    return this->layers_.at(index).settings;
+}
+
+
+void LayeredCanvas::DrawCanvas_(GraphicsContext &context, const wxRect &stale)
+{
+    for (auto &layer: this->layers_)
+    {
+        if (!layer.settings.isVisible)
+        {
+            continue;
+        }
+
+        this->UpdateLayer_(layer, context);
+        context.SetComposition(layer.settings.composition);
+
+        // Only the tiles within the stale area of the canvas are composited.
+        for (auto &tile: layer.tiles)
+        {
+            if (tile.graphicsBitmap.IsNull() || !tile.rect.Intersects(stale))
+            {
+                continue;
+            }
+
+            context->DrawBitmap(
+                tile.graphicsBitmap,
+                tile.rect.x,
+                tile.rect.y,
+                tile.rect.width,
+                tile.rect.height);
+        }
+    }
+
+    context.SetComposition(Composition::over);
+}
+
+
+void LayeredCanvas::UpdateLayer_(Layer &layer, GraphicsContext &context)
+{
+    auto backingSize = this->GetBackingSize();
+    auto scale = this->GetContentScaleFactor();
+
+    if (layer.size != backingSize || layer.scale != scale)
+    {
+        layer.tiles.clear();
+
+        auto tiles = MakeTiles(
+            {backingSize.GetWidth(), backingSize.GetHeight()},
+            tileSize);
+
+        for (auto &rect: tiles)
+        {
+            // Bitmaps are allocated when the tile is first drawn.
+            layer.tiles.push_back({rect, {}, {}});
+        }
+
+        layer.size = backingSize;
+        layer.scale = scale;
+        layer.stale = wxRect(backingSize);
+    }
+
+    if (!layer.stale)
+    {
+        return;
+    }
+
+    auto stale = *layer.stale;
+    layer.stale.reset();
+
+    for (auto &tile: layer.tiles)
+    {
+        auto area = tile.rect.Intersect(stale);
+
+        if (area.IsEmpty())
+        {
+            continue;
+        }
+
+        if (!tile.bitmap.IsOk())
+        {
+            tile.bitmap.CreateWithDIPSize(tile.rect.GetSize(), scale, 32);
+            tile.bitmap.UseAlpha();
+
+            // A new bitmap holds nothing, so all of it is drawn.
+            area = tile.rect;
+        }
+
+        {
+            wxMemoryDC memoryDc(tile.bitmap);
+            GraphicsContext tileContext(memoryDc);
+            DrawLayerTile(tileContext, tile.rect, area, layer.draw);
+
+            // The context is flushed to the bitmap when it is destroyed,
+            // before the memory DC releases it.
+        }
+
+        tile.graphicsBitmap = context->CreateBitmap(tile.bitmap);
+    }
+}
+
+
+void AddStaleRect(std::optional<wxRect> &stale, const wxRect &rect)
+{
+    if (stale)
+    {
+        stale->Union(rect);
+    }
+    else
+    {
+        stale = rect;
+    }
+}
+
+
+void DrawLayerTile(
+    GraphicsContext &context,
+    const wxRect &tile,
+    const wxRect &area,
+    const LayeredCanvas::DrawLayer &draw)
+{
+    context->Translate(-tile.x, -tile.y);
+    context->Clip(area.x, area.y, area.width, area.height);
+
+    // Replace area with transparent pixels, instead of drawing over it.
+    context.SetComposition(Composition::source);
+    context->SetPen(wxNullPen);
+    context->SetBrush(wxBrush(wxColour(0, 0, 0, wxALPHA_TRANSPARENT)));
+    context->DrawRectangle(area.x, area.y, area.width, area.height);
+    context.SetComposition(Composition::over);
+
+    draw(context, area);
+}
+
+
+} // end namespace wxpex
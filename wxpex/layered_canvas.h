@@ -0,0 +1,154 @@
+#pragma once
+
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "wxpex/canvas.h"
+
+
+namespace wxpex
+{
+
+
+class LayerSettings
+{
+public:
+    LayerSettings()
+        :
+        composition(wxpex::Composition::over),
+        isVisible(true)
+    {
+
+    }
+
+    // All setting functions return a reference to this instance so they can be
+    // chained.
+    //
+    // settings.Composition(Composition::add).Visible(false);
+
+    // How the layer combines with the layers below it.
+    LayerSettings & Composition(wxpex::Composition value)
+    {
+        this->composition = value;
+        return *this;
+    }
+
+    LayerSettings & Visible(bool value)
+    {
+        this->isVisible = value;
+        return *this;
+    }
+
+    wxpex::Composition composition;
+    bool isVisible;
+};
+
+
+/**
+ ** A Canvas made of a stack of layers, each drawn into its own transparent
+ ** bitmaps and composited in order, bottom first.
+ **
+ ** A layer is only drawn again when it is invalidated, or when the canvas
+ ** grows beyond its bitmaps. Invalidating one layer, or changing how a layer
+ ** is composited, costs one composite of the cached bitmaps, so a cursor on
+ ** its own layer can move over a costly background without drawing it again.
+ **
+ ** Each layer is divided into tiles of tileSize, each with a persistent
+ ** bitmap. Invalidating part of a layer only draws, and converts for
+ ** compositing, the tiles that overlap it.
+ **
+ ** Layer tiles cover the canvas backing bitmap at its scale factor, so they
+ ** are reallocated no more often than it is.
+ **
+ ** Must only be used from the wx event loop thread.
+ **/
+class LayeredCanvas: public Canvas
+{
+public:
+    static constexpr int tileSize = 256;
+
+    /**
+     ** Draws the part of a layer within stale.
+     **
+     ** The context is clipped to stale, which is transparent.
+     **/
+    using DrawLayer = std::function<void(GraphicsContext &, const wxRect &)>;
+
+    LayeredCanvas(wxWindow *parent, wxWindowID id = wxID_ANY);
+
+    // Adds a layer above the others, and returns its index.
+    size_t AddLayer(
+        const DrawLayer &drawLayer,
+        const LayerSettings &settings = LayerSettings());
+
+    size_t GetLayerCount() const;
+
+    // Draws the layer again before the next composite.
+    void InvalidateLayer(size_t index);
+
+    // Draws only rect of the layer again before the next composite.
+    void InvalidateLayer(size_t index, const wxRect &rect);
+
+    // Only composites again. The layer is not drawn.
+    void SetComposition(size_t index, Composition composition);
+
+    // Only composites again. A hidden layer is not drawn until it is shown.
+    void SetVisible(size_t index, bool isVisible);
+
+    const LayerSettings & GetLayerSettings(size_t index) const;
+
+private:
+    struct Tile
+    {
+        wxRect rect;
+
+        // Drawn through a wxMemoryDC, and converted to graphicsBitmap for
+        // compositing each time it is drawn.
+        wxBitmap bitmap;
+        wxGraphicsBitmap graphicsBitmap;
+    };
+
+    struct Layer
+    {
+        DrawLayer draw;
+        LayerSettings settings;
+        std::vector<Tile> tiles;
+        wxSize size;
+        double scale;
+        std::optional<wxRect> stale;
+    };
+
+    void DrawCanvas_(GraphicsContext &context, const wxRect &stale) override;
+
+    // Draws the stale tiles of layer, dividing it into new tiles if the
+    // backing bitmap has changed.
+    void UpdateLayer_(Layer &layer, GraphicsContext &context);
+
+    std::vector<Layer> layers_;
+};
+
+
+// Adds rect to stale, which holds no value when nothing is stale.
+void AddStaleRect(std::optional<wxRect> &stale, const wxRect &rect);
+
+
+/**
+ ** Draws the part of a layer within area into the tile of the layer at tile.
+ **
+ ** The context draws into the tile, with its origin at the top left corner
+ ** of the tile. It is translated to layer coordinates and clipped to area,
+ ** which is cleared to transparent before draw is called.
+ **
+ ** LayeredCanvas draws each of its tiles with this function, which does not
+ ** need a window.
+ **/
+void DrawLayerTile(
+    GraphicsContext &context,
+    const wxRect &tile,
+    const wxRect &area,
+    const LayeredCanvas::DrawLayer &draw);
+
+
+} // end namespace wxpex
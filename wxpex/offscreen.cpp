@@ -0,0 +1,241 @@
+#include "wxpex/offscreen.h"
+
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+
+namespace wxpex
+{
+
+
+namespace
+{
+
+
+void CopyTile(
+    wxImage &destination,
+    const wxImage &tileImage,
+    const wxRect &tile)
+{
+    auto destinationWidth = static_cast<size_t>(destination.GetWidth());
+    auto tileWidth = static_cast<size_t>(tile.GetWidth());
+    auto left = static_cast<size_t>(tile.GetLeft());
+
+    auto destinationData = destination.GetData();
+    auto destinationAlpha = destination.GetAlpha();
+    auto tileData = tileImage.GetData();
+    auto tileAlpha = tileImage.GetAlpha();
+
+    for (int row = 0; row < tile.GetHeight(); ++row)
+    {
+        auto tileRow = static_cast<size_t>(row);
+        auto destinationRow = static_cast<size_t>(tile.GetTop() + row);
+        auto destinationOffset = destinationRow * destinationWidth + left;
+        auto tileOffset = tileRow * tileWidth;
+
+        std::memcpy(
+            destinationData + destinationOffset * 3,
+            tileData + tileOffset * 3,
+            tileWidth * 3);
+
+        std::memcpy(
+            destinationAlpha + destinationOffset,
+            tileAlpha + tileOffset,
+            tileWidth);
+    }
+}
+
+
+void RenderTile(
+    wxImage &destination,
+    const wxRect &tile,
+    const DrawTile &drawTile)
+{
+    auto tileImage = MakeTransparentImage(
+        tau::Size<int>(tile.GetWidth(), tile.GetHeight()));
+
+    {
+        GraphicsContext context(tileImage);
+
+        if (!context)
+        {
+            throw GraphicsError("Unable to create an image context");
+        }
+
+        context->Clip(0, 0, tile.GetWidth(), tile.GetHeight());
+        context->Translate(-tile.GetLeft(), -tile.GetTop());
+
+        drawTile(context, tile);
+
+        // The tile image is updated when the context is destroyed.
+    }
+
+    // Tiles do not overlap, so workers write to disjoint parts of
+    // destination.
+    CopyTile(destination, tileImage, tile);
+}
+
+
+} // end anonymous namespace
+
+
+wxImage MakeTransparentImage(const tau::Size<int> &size)
+{
+    if (size.width < 1 || size.height < 1)
+    {
+        throw std::invalid_argument("Image size must be positive");
+    }
+
+    wxImage result(size.width, size.height, true);
+    result.InitAlpha();
+
+    std::memset(
+        result.GetAlpha(),
+        0,
+        static_cast<size_t>(size.width) * static_cast<size_t>(size.height));
+
+    return result;
+}
+
+
+std::vector<wxRect> MakeTiles(const tau::Size<int> &size, int tileSize)
+{
+    if (tileSize < 1)
+    {
+        throw std::invalid_argument("tileSize must be positive");
+    }
+
+    std::vector<wxRect> result;
+
+    for (int top = 0; top < size.height; top += tileSize)
+    {
+        auto height = std::min(tileSize, size.height - top);
+
+        for (int left = 0; left < size.width; left += tileSize)
+        {
+            auto width = std::min(tileSize, size.width - left);
+            result.emplace_back(left, top, width, height);
+        }
+    }
+
+    return result;
+}
+
+
+wxImage RenderOffscreen(
+    const tau::Size<int> &size,
+    const DrawTile &drawTile,
+    const OffscreenSettings &settings)
+{
+    auto result = MakeTransparentImage(size);
+    auto tiles = MakeTiles(size, settings.tileSize);
+
+    // The default renderer is created on first use, which must not race
+    // between workers.
+    wxGraphicsRenderer::GetDefaultRenderer();
+
+    auto threadCount = std::min(
+        static_cast<size_t>(std::max(1u, settings.threadCount)),
+        tiles.size());
+
+    if (threadCount <= 1)
+    {
+        for (auto &tile: tiles)
+        {
+            RenderTile(result, tile, drawTile);
+        }
+
+        return result;
+    }
+
+    std::atomic<size_t> nextTile{0};
+    std::atomic<bool> isCancelled{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto work = [&]() -> void
+    {
+        while (!isCancelled)
+        {
+            auto index = nextTile++;
+
+            if (index >= tiles.size())
+            {
+                return;
+            }
+
+            try
+            {
+                RenderTile(result, tiles[index], drawTile);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(errorMutex);
+
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+
+                isCancelled = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+
+    for (size_t i = 1; i < threadCount; ++i)
+    {
+        workers.emplace_back(work);
+    }
+
+    // The calling thread renders tiles too.
+    work();
+
+    for (auto &worker: workers)
+    {
+        worker.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+
+    return result;
+}
+
+
+void Composite(
+    wxImage &destination,
+    const wxImage &source,
+    const wxPoint &position,
+    Composition composition)
+{
+    GraphicsContext context(destination);
+
+    if (!context)
+    {
+        throw GraphicsError("Unable to create an image context");
+    }
+
+    context.SetComposition(composition);
+
+    // A wxGraphicsBitmap does not need a wxBitmap, so this also works without
+    // a window.
+    auto bitmap = context->CreateBitmapFromImage(source);
+
+    context->DrawBitmap(
+        bitmap,
+        position.x,
+        position.y,
+        source.GetWidth(),
+        source.GetHeight());
+}
+
+
+} // end namespace wxpex
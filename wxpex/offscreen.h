@@ -0,0 +1,117 @@
+#pragma once
+
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <tau/size.h>
+
+#include "wxpex/ignores.h"
+
+WXSHIM_PUSH_IGNORES
+#include <wx/image.h>
+WXSHIM_POP_IGNORES
+
+#include "wxpex/graphics.h"
+
+
+namespace wxpex
+{
+
+
+class OffscreenSettings
+{
+public:
+    static constexpr int defaultTileSize = 256;
+
+    OffscreenSettings()
+        :
+        tileSize(defaultTileSize),
+        threadCount(std::max(1u, std::thread::hardware_concurrency()))
+    {
+
+    }
+
+    // All setting functions return a reference to this instance so they can be
+    // chained.
+    //
+    // settings.TileSize(512).ThreadCount(4);
+
+    // The side of the square tiles rendered by each worker.
+    OffscreenSettings & TileSize(int value)
+    {
+        this->tileSize = value;
+        return *this;
+    }
+
+    // Defaults to the number of hardware threads.
+    OffscreenSettings & ThreadCount(unsigned value)
+    {
+        this->threadCount = value;
+        return *this;
+    }
+
+    int tileSize;
+    unsigned threadCount;
+};
+
+
+/**
+ ** Draws the part of the canvas within tile.
+ **
+ ** The context is transformed so that drawing uses canvas coordinates, and
+ ** clipped to the tile. The whole scene may be drawn, but culling against
+ ** tile avoids wasted work.
+ **
+ ** Called concurrently from worker threads, each with its own context.
+ **
+ ** wx GDI objects share reference counts that are not atomic, so drawTile
+ ** must not use a wxPen, wxBrush, wxFont, or wxColour that another thread
+ ** may also be using, including stock objects like *wxRED_BRUSH. Create
+ ** pens with wxGraphicsPenInfo, and other objects on the worker thread, then
+ ** pass them to the context's own CreatePen and CreateBrush.
+ **/
+using DrawTile = std::function<void(GraphicsContext &, const wxRect &tile)>;
+
+
+// Returns an image with an alpha channel, initialized to transparent.
+wxImage MakeTransparentImage(const tau::Size<int> &size);
+
+
+// Divides the canvas into tiles, in row-major order.
+std::vector<wxRect> MakeTiles(const tau::Size<int> &size, int tileSize);
+
+
+/**
+ ** Renders a canvas of size without a window, splitting it into tiles that
+ ** are drawn in parallel.
+ **
+ ** Each tile is drawn into its own wxImage by a GraphicsContext created in the
+ ** worker thread, then copied into its place in the result. wxBitmap and
+ ** wxDC are never used, so rendering does not require a visible window, and
+ ** drawTile must not use them either.
+ **
+ ** An exception thrown by drawTile is rethrown after all workers have
+ ** stopped.
+ **
+ ** @return The rendered canvas, with an alpha channel.
+ **/
+wxImage RenderOffscreen(
+    const tau::Size<int> &size,
+    const DrawTile &drawTile,
+    const OffscreenSettings &settings = OffscreenSettings());
+
+
+/**
+ ** Draws source onto destination at position, using composition to combine
+ ** them.
+ **/
+void Composite(
+    wxImage &destination,
+    const wxImage &source,
+    const wxPoint &position,
+    Composition composition = Composition::over);
+
+
+} // end namespace wxpex
@@ -0,0 +1,413 @@
+#include "wxpex/paint_profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include "wxpex/widget_names.h"
+
+
+namespace wxpex
+{
+
+
+PaintHistogram::PaintHistogram(size_t windowSize)
+    :
+    windowSize_(windowSize),
+    samples_(),
+    next_(0),
+    totalCount_(0),
+    buckets_{}
+{
+    if (windowSize == 0)
+    {
+        throw std::invalid_argument("windowSize must be at least 1");
+    }
+
+    this->samples_.reserve(windowSize);
+}
+
+
+size_t PaintHistogram::GetBucket(Duration duration)
+{
+    auto found = std::lower_bound(
+        bucketLimits_ms.begin(),
+        bucketLimits_ms.end(),
+        duration.count());
+
+    return static_cast<size_t>(
+        std::distance(bucketLimits_ms.begin(), found));
+}
+
+
+void PaintHistogram::Add(Duration duration)
+{
+    ++this->buckets_[GetBucket(duration)];
+    ++this->totalCount_;
+
+    if (this->samples_.size() < this->windowSize_)
+    {
+        this->samples_.push_back(duration);
+        this->next_ = this->samples_.size() % this->windowSize_;
+
+        return;
+    }
+
+    // The oldest paint leaves the window.
+    auto &oldest = this->samples_[this->next_];
+    --this->buckets_[GetBucket(oldest)];
+    oldest = duration;
+    this->next_ = (this->next_ + 1) % this->windowSize_;
+}
+
+
+size_t PaintHistogram::GetCount() const
+{
+    return this->samples_.size();
+}
+
+
+size_t PaintHistogram::GetTotalCount() const
+{
+    return this->totalCount_;
+}
+
+
+const PaintHistogram::Buckets & PaintHistogram::GetBuckets() const
+{
+    return this->buckets_;
+}
+
+
+std::optional<PaintHistogram::Duration> PaintHistogram::GetLast() const
+{
+    if (this->samples_.empty())
+    {
+        return {};
+    }
+
+    auto last = (this->next_ + this->samples_.size() - 1)
+        % this->samples_.size();
+
+    return this->samples_[last];
+}
+
+
+PaintHistogram::Duration PaintHistogram::GetMean() const
+{
+    if (this->samples_.empty())
+    {
+        return {};
+    }
+
+    Duration total{};
+
+    for (auto &sample: this->samples_)
+    {
+        total += sample;
+    }
+
+    return total / static_cast<double>(this->samples_.size());
+}
+
+
+PaintHistogram::Duration PaintHistogram::GetMaximum() const
+{
+    if (this->samples_.empty())
+    {
+        return {};
+    }
+
+    return *std::max_element(this->samples_.begin(), this->samples_.end());
+}
+
+
+PaintHistogram::Duration PaintHistogram::GetPercentile(double fraction) const
+{
+    if (this->samples_.empty())
+    {
+        return {};
+    }
+
+    fraction = std::clamp(fraction, 0.0, 1.0);
+
+    auto sorted = this->samples_;
+
+    auto rank = static_cast<size_t>(
+        std::ceil(fraction * static_cast<double>(sorted.size())));
+
+    auto index = std::max<size_t>(rank, 1) - 1;
+
+    std::nth_element(
+        sorted.begin(),
+        sorted.begin() + static_cast<std::ptrdiff_t>(index),
+        sorted.end());
+
+    return sorted[index];
+}
+
+
+namespace
+{
+
+
+struct Profile
+{
+    bool isEnabled = false;
+    bool isOverlayEnabled = false;
+    std::map<wxWindow *, PaintHistogram> histograms;
+
+    // The area covered by the most recent overlay of each window.
+    std::map<wxWindow *, wxRect> overlays;
+};
+
+
+Profile profile_;
+
+
+void OnDestroy(wxWindowDestroyEvent &event)
+{
+    event.Skip();
+
+    // Only the window being destroyed is removed, not its children, which
+    // receive their own event.
+    profile_.histograms.erase(event.GetWindow());
+    profile_.overlays.erase(event.GetWindow());
+}
+
+
+std::string GetName(wxWindow *window)
+{
+    auto name = GetWidgetName(window);
+
+    if (name == "None")
+    {
+        // Fall back to the name given to the wxWindow.
+        return window->GetName().ToStdString();
+    }
+
+    return name;
+}
+
+
+} // end anonymous namespace
+
+
+void PaintProfiler::Enable()
+{
+    profile_.isEnabled = true;
+}
+
+
+void PaintProfiler::Disable()
+{
+    for (auto &it: profile_.histograms)
+    {
+        it.first->Unbind(wxEVT_DESTROY, &OnDestroy);
+    }
+
+    profile_.histograms.clear();
+    profile_.overlays.clear();
+    profile_.isEnabled = false;
+}
+
+
+bool PaintProfiler::IsEnabled()
+{
+    return profile_.isEnabled;
+}
+
+
+void PaintProfiler::SetOverlayEnabled(bool isOverlayEnabled)
+{
+    profile_.isOverlayEnabled = isOverlayEnabled;
+}
+
+
+bool PaintProfiler::IsOverlayEnabled()
+{
+    return profile_.isEnabled && profile_.isOverlayEnabled;
+}
+
+
+void PaintProfiler::Record(wxWindow *window, Duration duration)
+{
+    if (!profile_.isEnabled)
+    {
+        return;
+    }
+
+    auto found = profile_.histograms.find(window);
+
+    if (found == profile_.histograms.end())
+    {
+        window->Bind(wxEVT_DESTROY, &OnDestroy);
+        found = profile_.histograms.emplace(window, PaintHistogram()).first;
+    }
+
+    found->second.Add(duration);
+}
+
+
+const PaintHistogram * PaintProfiler::GetHistogram(wxWindow *window)
+{
+    auto found = profile_.histograms.find(window);
+
+    if (found == profile_.histograms.end())
+    {
+        return nullptr;
+    }
+
+    return &found->second;
+}
+
+
+void PaintProfiler::DrawOverlay(GraphicsContext &context, wxWindow *window)
+{
+    auto histogram = GetHistogram(window);
+
+    if (!histogram || !histogram->GetLast())
+    {
+        return;
+    }
+
+    // The paint in progress is recorded after the overlay is drawn, so the
+    // overlay shows the paints before it.
+    std::ostringstream last;
+    last << std::fixed << std::setprecision(2)
+        << histogram->GetLast()->count() << " ms";
+
+    std::ostringstream percentile;
+    percentile << std::fixed << std::setprecision(2)
+        << "p95 " << histogram->GetPercentile(0.95).count();
+
+    MaintainTransform maintainTransform(context);
+    context->SetTransform(context->CreateMatrix());
+
+    auto font = wxFont(wxFontInfo(7).Family(wxFONTFAMILY_TELETYPE));
+    context->SetFont(font, *wxWHITE);
+
+    double lastWidth;
+    double percentileWidth;
+    double lineHeight;
+    context->GetTextExtent(last.str(), &lastWidth, &lineHeight);
+    context->GetTextExtent(percentile.str(), &percentileWidth, &lineHeight);
+
+    auto width = std::max(lastWidth, percentileWidth) + 4.0;
+    auto height = 2.0 * lineHeight + 4.0;
+
+    context->SetPen(wxNullPen);
+    context->SetBrush(wxBrush(wxColour(0, 0, 0, 160)));
+    context->DrawRectangle(0.0, 0.0, width, height);
+    context->DrawText(last.str(), 2.0, 2.0);
+    context->DrawText(percentile.str(), 2.0, 2.0 + lineHeight);
+
+    profile_.overlays[window] = wxRect(
+        0,
+        0,
+        static_cast<int>(std::ceil(width)),
+        static_cast<int>(std::ceil(height)));
+}
+
+
+void PaintProfiler::RefreshOverlay(wxWindow *window)
+{
+    if (!IsOverlayEnabled())
+    {
+        return;
+    }
+
+    auto found = profile_.overlays.find(window);
+
+    if (found == profile_.overlays.end())
+    {
+        return;
+    }
+
+    if (window->GetUpdateRegion().Contains(found->second) == wxInRegion)
+    {
+        // The overlay was drawn by this paint.
+        return;
+    }
+
+    // A partial paint left the overlay showing an older paint. Bypass any
+    // override of Refresh, as only the overlay needs to be drawn again.
+    window->wxWindow::Refresh(false, &found->second);
+}
+
+
+std::ostream & PaintProfiler::WriteReport(std::ostream &output)
+{
+    std::vector<std::pair<wxWindow *, const PaintHistogram *>> ordered;
+
+    for (auto &[window, histogram]: profile_.histograms)
+    {
+        ordered.emplace_back(window, &histogram);
+    }
+
+    std::sort(
+        ordered.begin(),
+        ordered.end(),
+        [](const auto &left, const auto &right) -> bool
+        {
+            return left.second->GetMean() > right.second->GetMean();
+        });
+
+    output << std::fixed << std::setprecision(3);
+
+    output << std::setw(10) << "paints"
+        << std::setw(10) << "mean"
+        << std::setw(10) << "p95"
+        << std::setw(10) << "max"
+        << "  widget (ms)\n";
+
+    for (auto &[window, histogram]: ordered)
+    {
+        output << std::setw(10) << histogram->GetTotalCount()
+            << std::setw(10) << histogram->GetMean().count()
+            << std::setw(10) << histogram->GetPercentile(0.95).count()
+            << std::setw(10) << histogram->GetMaximum().count()
+            << "  " << GetName(window) << '\n';
+    }
+
+    return output;
+}
+
+
+std::ostream & PaintProfiler::WriteHistograms(std::ostream &output)
+{
+    for (auto &[window, histogram]: profile_.histograms)
+    {
+        output << GetName(window) << '\n';
+
+        auto &buckets = histogram.GetBuckets();
+
+        for (size_t i = 0; i < buckets.size(); ++i)
+        {
+            if (i < PaintHistogram::bucketLimits_ms.size())
+            {
+                output << "  <= " << std::setw(7)
+                    << PaintHistogram::bucketLimits_ms[i];
+            }
+            else
+            {
+                output << "   > " << std::setw(7)
+                    << PaintHistogram::bucketLimits_ms.back();
+            }
+
+            auto barLength = (buckets[i] * 40)
+                / std::max<size_t>(histogram.GetCount(), 1);
+
+            output << " ms: " << std::setw(6) << buckets[i] << ' '
+                << std::string(barLength, '#') << '\n';
+        }
+    }
+
+    return output;
+}
+
+
+} // end namespace wxpex
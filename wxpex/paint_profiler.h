@@ -0,0 +1,180 @@
+#pragma once
+
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+#include "wxpex/wxshim.h"
+#include "wxpex/graphics.h"
+
+
+namespace wxpex
+{
+
+
+/**
+ ** Paint durations of the most recent windowSize paints, counted in
+ ** buckets with roughly logarithmic limits.
+ **/
+class PaintHistogram
+{
+public:
+    using Duration = std::chrono::duration<double, std::milli>;
+
+    static constexpr size_t defaultWindowSize = 240;
+
+    // The upper limit of each bucket except the last, which is unbounded.
+    static constexpr std::array<double, 11> bucketLimits_ms{
+        0.1, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 33.0, 66.0, 133.0};
+
+    static constexpr size_t bucketCount = bucketLimits_ms.size() + 1;
+
+    using Buckets = std::array<size_t, bucketCount>;
+
+    PaintHistogram(size_t windowSize = defaultWindowSize);
+
+    static size_t GetBucket(Duration duration);
+
+    void Add(Duration duration);
+
+    // The number of paints in the window.
+    size_t GetCount() const;
+
+    // The number of paints since the histogram was created.
+    size_t GetTotalCount() const;
+
+    const Buckets & GetBuckets() const;
+
+    std::optional<Duration> GetLast() const;
+
+    Duration GetMean() const;
+
+    Duration GetMaximum() const;
+
+    /**
+     ** @param fraction From 0 to 1, so 0.95 is the 95th percentile.
+     ** @return The smallest duration in the window that is at least as long
+     ** as fraction of the paints.
+     **/
+    Duration GetPercentile(double fraction) const;
+
+private:
+    size_t windowSize_;
+
+    // A ring buffer of the paints in the window.
+    std::vector<Duration> samples_;
+    size_t next_;
+
+    size_t totalCount_;
+    Buckets buckets_;
+};
+
+
+/**
+ ** Records how long each custom-painted widget takes to paint, keyed by the
+ ** names given to RegisterWidgetName.
+ **
+ ** Paint handlers opt in with PROFILE_PAINT at the top of the handler, before
+ ** the GraphicsContext is created, so that creating and flushing the context
+ ** are included. Handlers may also call PROFILE_PAINT_OVERLAY to draw their
+ ** recent paint times over the widget.
+ **
+ ** The profiler is off by default. While disabled, a profiled paint only pays
+ ** for a flag check.
+ **
+ ** Must only be used from the wx event loop thread.
+ **/
+class PaintProfiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Duration = PaintHistogram::Duration;
+
+    static void Enable();
+
+    // Stop recording, and discard everything that has been recorded.
+    static void Disable();
+
+    static bool IsEnabled();
+
+    // Draw recent paint times over each profiled widget.
+    static void SetOverlayEnabled(bool isOverlayEnabled);
+
+    static bool IsOverlayEnabled();
+
+    static void Record(wxWindow *window, Duration duration);
+
+    // The recorded paints of window, if there are any.
+    static const PaintHistogram * GetHistogram(wxWindow *window);
+
+    static void DrawOverlay(GraphicsContext &context, wxWindow *window);
+
+    /**
+     ** Called at the end of each profiled paint. When the update region did
+     ** not cover the overlay of window, the overlay is refreshed so that it
+     ** shows the newest paint.
+     **/
+    static void RefreshOverlay(wxWindow *window);
+
+    /**
+     ** Writes one line per profiled widget, with paint count, mean, 95th
+     ** percentile and maximum in milliseconds, slowest first.
+     **/
+    static std::ostream & WriteReport(std::ostream &output);
+
+    // Writes the histogram of each profiled widget.
+    static std::ostream & WriteHistograms(std::ostream &output);
+};
+
+
+// Times the enclosing scope as a paint of window.
+class ScopedPaintTimer
+{
+public:
+    ScopedPaintTimer(wxWindow *window)
+        :
+        window_(window),
+        start_()
+    {
+        if (PaintProfiler::IsEnabled())
+        {
+            this->start_ = PaintProfiler::Clock::now();
+        }
+    }
+
+    ~ScopedPaintTimer()
+    {
+        if (this->start_)
+        {
+            PaintProfiler::Record(
+                this->window_,
+                PaintProfiler::Clock::now() - *this->start_);
+
+            PaintProfiler::RefreshOverlay(this->window_);
+        }
+    }
+
+    ScopedPaintTimer(const ScopedPaintTimer &) = delete;
+    ScopedPaintTimer & operator=(const ScopedPaintTimer &) = delete;
+
+private:
+    wxWindow *window_;
+    std::optional<PaintProfiler::Clock::time_point> start_;
+};
+
+
+} // end namespace wxpex
+
+
+#define PROFILE_PAINT(window) \
+    wxpex::ScopedPaintTimer paintTimer(window);
+
+
+#define PROFILE_PAINT_OVERLAY(context, window) \
+    if (wxpex::PaintProfiler::IsOverlayEnabled()) \
+    { \
+        wxpex::PaintProfiler::DrawOverlay(context, window); \
+    }
@@ -0,0 +1,506 @@
+#include "wxpex/plot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "wxpex/color.h"
+
+
+namespace wxpex
+{
+
+
+uint64_t PlotBatch::GetNextSequence()
+{
+    static std::atomic<uint64_t> sequence{0};
+
+    return ++sequence;
+}
+
+
+Plot::Plot(
+    wxWindow *parent,
+    PlotControl control,
+    const PlotSettings &settings)
+    :
+    Canvas(parent, wxID_ANY),
+    settings_(settings),
+    history_(settings.capacity),
+    endpoint_(this, control, &Plot::OnBatch_),
+    view_(1.0, 0.0, 0.0, -1.0, 0.0, 0.0),
+    viewSize_(),
+    isFollowing_(true),
+    hasCapturedMouse_(false),
+    dragPosition_(),
+    columns_(),
+    points_(),
+    lines_()
+{
+    this->Bind(wxEVT_LEFT_DOWN, &Plot::OnMouseEvents_, this);
+    this->Bind(wxEVT_MOTION, &Plot::OnMouseEvents_, this);
+    this->Bind(wxEVT_LEFT_UP, &Plot::OnMouseEvents_, this);
+    this->Bind(wxEVT_MOUSEWHEEL, &Plot::OnMouseWheel_, this);
+    this->Bind(wxEVT_LEFT_DCLICK, &Plot::OnDoubleClick_, this);
+
+    this->Bind(
+        wxEVT_MOUSE_CAPTURE_LOST,
+        &Plot::OnMouseCaptureLost_,
+        this);
+}
+
+
+void Plot::Append(const float *samples, size_t count)
+{
+    auto previousEnd = static_cast<double>(this->history_.GetEnd());
+    this->history_.Append(samples, count);
+
+    if (this->isFollowing_)
+    {
+        this->Follow_();
+        this->Refresh(false);
+
+        return;
+    }
+
+    // While the user looks at older samples, a batch only needs a paint if
+    // it lands in view, or pushes samples in view out of the history.
+    auto first = this->GetFirstVisible_();
+
+    auto last = first
+        + this->GetSamplesPerPixel_() * static_cast<double>(this->viewSize_.x);
+
+    if (
+        last >= previousEnd
+        || first < static_cast<double>(this->history_.GetBegin()))
+    {
+        this->Refresh(false);
+    }
+}
+
+
+const PlotHistory & Plot::GetHistory() const
+{
+    return this->history_;
+}
+
+
+void Plot::Fit()
+{
+    this->isFollowing_ = true;
+
+    auto width = static_cast<double>(this->viewSize_.x);
+    auto height = static_cast<double>(this->viewSize_.y);
+
+    if (this->history_.IsEmpty() || width < 1.0 || height < 1.0)
+    {
+        return;
+    }
+
+    auto begin = this->history_.GetBegin();
+    auto envelope = this->history_.GetEnvelope(begin, this->history_.GetEnd());
+
+    double low = envelope.minimum;
+    double high = envelope.maximum;
+
+    // A little room above and below, and some height for a flat line.
+    auto margin = 0.05 * (high - low);
+
+    if (margin == 0.0)
+    {
+        margin = 0.5;
+    }
+
+    low -= margin;
+    high += margin;
+
+    this->view_.a = width / static_cast<double>(this->history_.GetCount());
+    this->view_.tx = -this->view_.a * static_cast<double>(begin);
+    this->view_.d = -height / (high - low);
+    this->view_.ty = -this->view_.d * high;
+
+    this->Refresh(false);
+}
+
+
+wxSize Plot::DoGetBestClientSize() const
+{
+    return wxSize(400, 200);
+}
+
+
+void Plot::OnBatch_(pex::Argument<PlotBatch> batch)
+{
+    this->Append(batch.samples.data(), batch.samples.size());
+}
+
+
+void Plot::DrawCanvas_(GraphicsContext &context, const wxRect &)
+{
+    auto clientSize = this->GetClientSize();
+
+    if (clientSize != this->viewSize_)
+    {
+        this->UpdateView_(clientSize);
+    }
+
+    if (this->history_.IsEmpty() || clientSize.x < 1)
+    {
+        return;
+    }
+
+    if (this->GetSamplesPerPixel_() >= PlotHistory::baseBinSize)
+    {
+        this->DrawEnvelopes_(context, clientSize.x);
+    }
+    else
+    {
+        this->DrawSamples_(context, clientSize.x);
+    }
+}
+
+
+void Plot::DrawEnvelopes_(GraphicsContext &context, int width)
+{
+    this->columns_.resize(static_cast<size_t>(width));
+
+    this->history_.GetColumns(
+        this->GetFirstVisible_(),
+        this->GetSamplesPerPixel_(),
+        this->columns_);
+
+    auto toPixel = [this](float value) -> double
+    {
+        return this->view_.d * value + this->view_.ty;
+    };
+
+    auto path = context->CreatePath();
+    size_t column = 0;
+
+    while (column < this->columns_.size())
+    {
+        if (this->columns_[column].IsEmpty())
+        {
+            ++column;
+
+            continue;
+        }
+
+        auto runBegin = column;
+
+        // Each column reaches to its neighbor on the left, as a line between
+        // them would, so the run is one connected shape.
+        auto previous = this->columns_[column];
+
+        while (
+            column < this->columns_.size()
+            && !this->columns_[column].IsEmpty())
+        {
+            auto envelope = this->columns_[column];
+            auto &extended = this->columns_[column];
+            extended.minimum = std::min(envelope.minimum, previous.maximum);
+            extended.maximum = std::max(envelope.maximum, previous.minimum);
+            previous = envelope;
+            ++column;
+        }
+
+        // The top edge from left to right, then the bottom edge back, at
+        // least a pixel apart.
+        for (auto index = runBegin; index < column; ++index)
+        {
+            auto &envelope = this->columns_[index];
+            auto top = toPixel(envelope.maximum);
+            auto bottom = toPixel(envelope.minimum);
+            auto middle = (top + bottom) / 2.0;
+            top = std::min(top, middle - 0.5);
+
+            auto left = static_cast<double>(index);
+
+            if (index == runBegin)
+            {
+                path.MoveToPoint(left, top);
+            }
+            else
+            {
+                path.AddLineToPoint(left, top);
+            }
+
+            path.AddLineToPoint(left + 1.0, top);
+        }
+
+        for (auto index = column; index-- > runBegin;)
+        {
+            auto &envelope = this->columns_[index];
+            auto top = toPixel(envelope.maximum);
+            auto bottom = toPixel(envelope.minimum);
+            auto middle = (top + bottom) / 2.0;
+            bottom = std::max(bottom, middle + 0.5);
+
+            auto left = static_cast<double>(index);
+            path.AddLineToPoint(left + 1.0, bottom);
+            path.AddLineToPoint(left, bottom);
+        }
+
+        path.CloseSubpath();
+    }
+
+    context->SetPen(wxNullPen);
+    context->SetBrush(wxBrush(ToWxColour(this->settings_.color)));
+    context->FillPath(path);
+}
+
+
+void Plot::DrawSamples_(GraphicsContext &context, int width)
+{
+    auto firstVisible = this->GetFirstVisible_();
+
+    auto lastVisible = firstVisible
+        + this->GetSamplesPerPixel_() * static_cast<double>(width);
+
+    // One more sample on each side, for the lines leaving the edges.
+    auto begin = static_cast<double>(this->history_.GetBegin());
+    auto end = static_cast<double>(this->history_.GetEnd());
+    auto first = std::max(std::floor(firstVisible) - 1.0, begin);
+    auto last = std::min(std::ceil(lastVisible) + 2.0, end);
+
+    if (last <= first)
+    {
+        return;
+    }
+
+    this->points_.clear();
+
+    for (
+        auto index = static_cast<uint64_t>(first);
+        index < static_cast<uint64_t>(last);
+        ++index)
+    {
+        this->points_.push_back(
+            {
+                static_cast<double>(index),
+                static_cast<double>(this->history_.Get(index))});
+    }
+
+    this->view_.TransformPoints(this->points_);
+
+    this->lines_.resize(this->points_.size());
+
+    std::transform(
+        this->points_.begin(),
+        this->points_.end(),
+        this->lines_.begin(),
+        [](const auto &point) -> wxPoint2DDouble
+        {
+            return wxPoint2DDouble(point.x, point.y);
+        });
+
+    auto color = ToWxColour(this->settings_.color);
+
+    if (this->lines_.size() == 1)
+    {
+        context->SetPen(wxNullPen);
+        context->SetBrush(wxBrush(color));
+
+        context->DrawRectangle(
+            this->lines_[0].m_x - 1.0,
+            this->lines_[0].m_y - 1.0,
+            2.0,
+            2.0);
+
+        return;
+    }
+
+    context->SetPen(wxPen(color, 1));
+    context->StrokeLines(this->lines_.size(), this->lines_.data());
+}
+
+
+void Plot::OnCanvasResized_(const wxSize &clientSize)
+{
+    this->UpdateView_(clientSize);
+    this->Refresh(false);
+}
+
+
+void Plot::OnMouseEvents_(wxMouseEvent &mouseEvent)
+{
+    if (mouseEvent.LeftDown())
+    {
+        if (!this->hasCapturedMouse_)
+        {
+            this->CaptureMouse();
+            this->hasCapturedMouse_ = true;
+        }
+
+        this->dragPosition_ = mouseEvent.GetPosition();
+
+        return;
+    }
+    else if (mouseEvent.LeftUp())
+    {
+        if (this->hasCapturedMouse_)
+        {
+            this->ReleaseMouse();
+            this->hasCapturedMouse_ = false;
+        }
+
+        return;
+    }
+
+    if (!this->hasCapturedMouse_ || !mouseEvent.LeftIsDown())
+    {
+        return;
+    }
+
+    auto position = mouseEvent.GetPosition();
+    auto offset = position - this->dragPosition_;
+    this->dragPosition_ = position;
+
+    this->view_.tx += offset.x;
+    this->view_.ty += offset.y;
+
+    // Following resumes when the newest sample is dragged back into view.
+    this->isFollowing_ = this->IsNewestVisible_();
+
+    this->Refresh(false);
+}
+
+
+void Plot::OnMouseWheel_(wxMouseEvent &mouseEvent)
+{
+    auto steps = static_cast<double>(mouseEvent.GetWheelRotation())
+        / static_cast<double>(mouseEvent.GetWheelDelta());
+
+    auto factor = std::pow(zoomStep, steps);
+    auto position = mouseEvent.GetPosition();
+
+    if (mouseEvent.ShiftDown())
+    {
+        // Keep the value under the pointer where it is.
+        auto y = static_cast<double>(position.y);
+        this->view_.d *= factor;
+        this->view_.ty = y - factor * (y - this->view_.ty);
+    }
+    else
+    {
+        // From the whole history in a quarter of the width, to two pixels
+        // per sample.
+        auto width = static_cast<double>(std::max(this->viewSize_.x, 1));
+        auto maximum = 2.0;
+
+        auto minimum = std::min(
+            maximum,
+            width / (4.0 * static_cast<double>(this->history_.GetCapacity())));
+
+        auto a = std::clamp(this->view_.a * factor, minimum, maximum);
+
+        factor = a / this->view_.a;
+
+        auto x = static_cast<double>(position.x);
+        this->view_.a = a;
+        this->view_.tx = x - factor * (x - this->view_.tx);
+
+        if (this->isFollowing_)
+        {
+            this->Follow_();
+        }
+    }
+
+    this->Refresh(false);
+}
+
+
+void Plot::OnDoubleClick_(wxMouseEvent &)
+{
+    this->Fit();
+}
+
+
+void Plot::OnMouseCaptureLost_(wxMouseCaptureLostEvent &)
+{
+    this->hasCapturedMouse_ = false;
+}
+
+
+void Plot::UpdateView_(const wxSize &clientSize)
+{
+    if (clientSize.x < 1 || clientSize.y < 1)
+    {
+        return;
+    }
+
+    auto width = static_cast<double>(clientSize.x);
+    auto height = static_cast<double>(clientSize.y);
+
+    if (this->viewSize_.x < 1 || this->viewSize_.y < 1)
+    {
+        // The first size, so the view comes from the settings.
+        this->view_.a =
+            width / static_cast<double>(this->settings_.GetVisibleSamples());
+
+        this->view_.tx = 0.0;
+        this->view_.d = -height / (this->settings_.high - this->settings_.low);
+        this->view_.ty = -this->view_.d * this->settings_.high;
+    }
+    else
+    {
+        // Stretch the view with the window.
+        auto horizontal = width / static_cast<double>(this->viewSize_.x);
+        auto vertical = height / static_cast<double>(this->viewSize_.y);
+
+        this->view_.a *= horizontal;
+        this->view_.tx *= horizontal;
+        this->view_.d *= vertical;
+        this->view_.ty *= vertical;
+    }
+
+    this->viewSize_ = clientSize;
+
+    if (this->isFollowing_)
+    {
+        this->Follow_();
+    }
+}
+
+
+void Plot::Follow_()
+{
+    auto width = static_cast<double>(this->viewSize_.x);
+    auto end = this->view_.a * static_cast<double>(this->history_.GetEnd());
+    auto begin = this->view_.a * static_cast<double>(this->history_.GetBegin());
+
+    if (end - begin < width)
+    {
+        // Until the samples fill the width, they start at the left edge.
+        this->view_.tx = -begin;
+    }
+    else
+    {
+        this->view_.tx = width - end;
+    }
+}
+
+
+bool Plot::IsNewestVisible_() const
+{
+    auto newest = this->view_.TransformPoint(
+        {static_cast<double>(this->history_.GetEnd()), 0.0});
+
+    return newest.x >= 0.0
+        && newest.x <= static_cast<double>(this->viewSize_.x) + 1.0;
+}
+
+
+double Plot::GetFirstVisible_() const
+{
+    return -this->view_.tx / this->view_.a;
+}
+
+
+double Plot::GetSamplesPerPixel_() const
+{
+    return 1.0 / this->view_.a;
+}
+
+
+} // end namespace wxpex
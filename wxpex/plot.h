@@ -0,0 +1,233 @@
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+#include <tau/color.h>
+#include <pex/endpoint.h>
+
+#include "wxpex/async.h"
+#include "wxpex/canvas.h"
+#include "wxpex/plot_history.h"
+
+
+namespace wxpex
+{
+
+
+class PlotSettings
+{
+public:
+    using Rgb = tau::Rgb<uint8_t>;
+
+    static constexpr size_t defaultCapacity = size_t(1) << 20;
+
+    PlotSettings()
+        :
+        capacity(defaultCapacity),
+        visibleSamples(0),
+        color{{0, 160, 255}},
+        low(-1.0),
+        high(1.0)
+    {
+
+    }
+
+    // All setting functions return a reference to this instance so they can be
+    // chained.
+    //
+    // settings.Capacity(10'000'000).VisibleSamples(100'000).Range(0.0, 5.0);
+
+    // The number of samples kept for panning back through the history.
+    PlotSettings & Capacity(size_t value)
+    {
+        this->capacity = value;
+        return *this;
+    }
+
+    // The number of samples across the width of the plot before zooming.
+    // 0 shows the whole capacity.
+    PlotSettings & VisibleSamples(size_t value)
+    {
+        this->visibleSamples = value;
+        return *this;
+    }
+
+    PlotSettings & Color(const Rgb &value)
+    {
+        this->color = value;
+        return *this;
+    }
+
+    // The values at the bottom and top of the plot before zooming.
+    PlotSettings & Range(double low_, double high_)
+    {
+        this->low = low_;
+        this->high = high_;
+        return *this;
+    }
+
+    size_t GetVisibleSamples() const
+    {
+        if (this->visibleSamples > 0)
+        {
+            return this->visibleSamples;
+        }
+
+        return this->capacity;
+    }
+
+    size_t capacity;
+    size_t visibleSamples;
+    Rgb color;
+    double low;
+    double high;
+};
+
+
+/**
+ ** Samples appended to a Plot.
+ **
+ ** Batches compare equal by sequence alone, so Async does not compare every
+ ** sample, and consecutive batches with the same samples are still delivered.
+ **/
+struct PlotBatch
+{
+    uint64_t sequence = 0;
+    std::vector<float> samples;
+
+    /**
+     ** Sequences are unique within the process, starting from 1, so a batch
+     ** never equals one sent earlier, even by another writer.
+     **
+     ** May be called from any thread.
+     **/
+    static uint64_t GetNextSequence();
+
+    bool operator==(const PlotBatch &other) const
+    {
+        return this->sequence == other.sequence;
+    }
+};
+
+
+using PlotAsync = Async<PlotBatch>;
+using PlotControl = typename PlotAsync::Control;
+
+
+/**
+ ** Sends batches of samples from a worker thread, through the worker control
+ ** of a PlotAsync, to a Plot connected to its wx control.
+ **
+ ** Every batch is queued for the wx event loop. Larger batches cost less per
+ ** sample to deliver.
+ **/
+class PlotWriter
+{
+public:
+    PlotWriter(PlotControl workerControl)
+        :
+        control_(workerControl)
+    {
+
+    }
+
+    void Write(std::vector<float> samples)
+    {
+        this->control_.Set(
+            PlotBatch{PlotBatch::GetNextSequence(), std::move(samples)});
+    }
+
+private:
+    PlotControl control_;
+};
+
+
+/**
+ ** A line plot of a stream of samples, drawn from the envelopes in a
+ ** PlotHistory.
+ **
+ ** When there are more samples than pixel columns, each column is a vertical
+ ** span from the minimum to the maximum of its samples, so the cost of a paint
+ ** depends on the width of the plot and not on the number of samples. Zoomed
+ ** in further, the samples are connected with lines.
+ **
+ ** The view is a GraphicsMatrix from sample number and value to pixels. Drag
+ ** to pan. The mouse wheel zooms in time about the pointer, and zooms the
+ ** values with shift held down. Double-click to fit the whole history.
+ **
+ ** While the newest sample is in view, the plot scrolls to follow new
+ ** samples. Panning away stops following, and panning back resumes it.
+ **/
+class Plot: public Canvas
+{
+public:
+    static constexpr auto observerName = "wxpex::Plot";
+
+    // Each click of the mouse wheel zooms by this factor.
+    static constexpr double zoomStep = 1.25;
+
+    Plot(
+        wxWindow *parent,
+        PlotControl control,
+        const PlotSettings &settings = PlotSettings());
+
+    // Appends samples from the wx event loop thread.
+    void Append(const float *samples, size_t count);
+
+    const PlotHistory & GetHistory() const;
+
+    // Shows the whole history, scaled to the range of its values.
+    void Fit();
+
+    wxSize DoGetBestClientSize() const override;
+
+private:
+    void OnBatch_(pex::Argument<PlotBatch> batch);
+
+    void DrawCanvas_(GraphicsContext &context, const wxRect &) override;
+
+    void DrawEnvelopes_(GraphicsContext &context, int width);
+
+    void DrawSamples_(GraphicsContext &context, int width);
+
+    void OnCanvasResized_(const wxSize &clientSize) override;
+
+    void OnMouseEvents_(wxMouseEvent &mouseEvent);
+
+    void OnMouseWheel_(wxMouseEvent &mouseEvent);
+
+    void OnDoubleClick_(wxMouseEvent &);
+
+    void OnMouseCaptureLost_(wxMouseCaptureLostEvent &);
+
+    // Keeps the view in proportion to a new client size.
+    void UpdateView_(const wxSize &clientSize);
+
+    // Scrolls the newest sample to the right edge.
+    void Follow_();
+
+    // True if the newest sample is within the width of the plot.
+    bool IsNewestVisible_() const;
+
+    double GetFirstVisible_() const;
+
+    double GetSamplesPerPixel_() const;
+
+    PlotSettings settings_;
+    PlotHistory history_;
+    pex::Endpoint<Plot, PlotControl> endpoint_;
+    GraphicsMatrix view_;
+    wxSize viewSize_;
+    bool isFollowing_;
+    bool hasCapturedMouse_;
+    wxPoint dragPosition_;
+
+    // Reused between paints.
+    std::vector<Envelope> columns_;
+    std::vector<GraphicsMatrix::Point> points_;
+    std::vector<wxPoint2DDouble> lines_;
+};
+
+
+} // end namespace wxpex
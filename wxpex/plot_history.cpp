@@ -0,0 +1,289 @@
+#include "wxpex/plot_history.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace wxpex
+{
+
+
+PlotHistory::PlotHistory(size_t capacity)
+    :
+    capacity_(capacity),
+    samples_(capacity),
+    levels_(),
+    end_(0)
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument("capacity must be at least 1");
+    }
+
+    size_t shift = 3;
+    static_assert(baseBinSize == 8);
+
+    // Add levels until one bin covers the whole history.
+    do
+    {
+        auto binSize = size_t(1) << shift;
+
+        // Two more bins than fit, for the partial bins at each end.
+        this->levels_.push_back(
+            {shift, std::vector<Envelope>(capacity / binSize + 2)});
+
+        ++shift;
+    }
+    while ((size_t(1) << (shift - 1)) < capacity);
+}
+
+
+void PlotHistory::Append(const float *samples, size_t count)
+{
+    if (count == 0)
+    {
+        // The levels are updated from the last appended sample.
+        return;
+    }
+
+    if (count > this->capacity_)
+    {
+        // Only the newest capacity samples will be kept.
+        auto skipped = count - this->capacity_;
+        samples += skipped;
+        count = this->capacity_;
+        this->end_ += skipped;
+    }
+
+    auto begin = this->end_;
+
+    // Copy into the ring, in at most two parts.
+    auto offset = static_cast<size_t>(begin % this->capacity_);
+    auto first = std::min(count, this->capacity_ - offset);
+
+    std::copy(samples, samples + first, this->samples_.begin() + offset);
+    std::copy(samples + first, samples + count, this->samples_.begin());
+
+    this->end_ += count;
+
+    this->UpdateBase_(begin, this->end_);
+
+    for (size_t level = 1; level < this->levels_.size(); ++level)
+    {
+        this->UpdateLevel_(level, begin, this->end_);
+    }
+}
+
+
+void PlotHistory::Append(const std::vector<float> &samples)
+{
+    this->Append(samples.data(), samples.size());
+}
+
+
+void PlotHistory::Clear()
+{
+    this->end_ = 0;
+}
+
+
+size_t PlotHistory::GetCapacity() const
+{
+    return this->capacity_;
+}
+
+
+uint64_t PlotHistory::GetBegin() const
+{
+    return (this->end_ > this->capacity_) ? this->end_ - this->capacity_ : 0;
+}
+
+
+uint64_t PlotHistory::GetEnd() const
+{
+    return this->end_;
+}
+
+
+size_t PlotHistory::GetCount() const
+{
+    return static_cast<size_t>(this->end_ - this->GetBegin());
+}
+
+
+bool PlotHistory::IsEmpty() const
+{
+    return this->end_ == 0;
+}
+
+
+float PlotHistory::Get(uint64_t index) const
+{
+    return this->samples_[static_cast<size_t>(index % this->capacity_)];
+}
+
+
+size_t PlotHistory::GetLevelCount() const
+{
+    return this->levels_.size();
+}
+
+
+size_t PlotHistory::GetBinSize(size_t level) const
+{
+    return size_t(1) << this->levels_.at(level).shift;
+}
+
+
+Envelope PlotHistory::GetEnvelope(uint64_t first, uint64_t last) const
+{
+    first = std::max(first, this->GetBegin());
+    last = std::min(last, this->end_);
+
+    Envelope result;
+    auto index = first;
+
+    while (index < last)
+    {
+        if (index % baseBinSize != 0 || index + baseBinSize > last)
+        {
+            result.Add(this->Get(index));
+            ++index;
+
+            continue;
+        }
+
+        // The largest aligned bin that fits in the rest of the range.
+        size_t level = 0;
+
+        while (level + 1 < this->levels_.size())
+        {
+            auto binSize = uint64_t(1) << this->levels_[level + 1].shift;
+
+            if (index % binSize != 0 || index + binSize > last)
+            {
+                break;
+            }
+
+            ++level;
+        }
+
+        auto shift = this->levels_[level].shift;
+        result.Add(this->GetBin_(level, index >> shift));
+        index += uint64_t(1) << shift;
+    }
+
+    return result;
+}
+
+
+void PlotHistory::GetColumns(
+    double first,
+    double samplesPerColumn,
+    std::vector<Envelope> &columns) const
+{
+    auto begin = static_cast<double>(this->GetBegin());
+    auto end = static_cast<double>(this->end_);
+
+    for (size_t column = 0; column < columns.size(); ++column)
+    {
+        auto columnFirst =
+            first + static_cast<double>(column) * samplesPerColumn;
+
+        auto columnLast = columnFirst + samplesPerColumn;
+
+        if (columnLast <= begin || columnFirst >= end)
+        {
+            columns[column] = Envelope{};
+
+            continue;
+        }
+
+        auto firstIndex =
+            static_cast<uint64_t>(std::max(std::floor(columnFirst), begin));
+
+        auto lastIndex =
+            static_cast<uint64_t>(std::min(std::floor(columnLast), end));
+
+        // Every column gets at least one sample.
+        lastIndex = std::max(lastIndex, firstIndex + 1);
+
+        columns[column] = this->GetEnvelope(firstIndex, lastIndex);
+    }
+}
+
+
+const Envelope & PlotHistory::GetBin_(size_t level, uint64_t bin) const
+{
+    auto &bins = this->levels_[level].bins;
+
+    return bins[static_cast<size_t>(bin % bins.size())];
+}
+
+
+Envelope & PlotHistory::GetBin_(size_t level, uint64_t bin)
+{
+    auto &bins = this->levels_[level].bins;
+
+    return bins[static_cast<size_t>(bin % bins.size())];
+}
+
+
+void PlotHistory::UpdateBase_(uint64_t begin, uint64_t end)
+{
+    auto index = begin;
+
+    while (index < end)
+    {
+        auto bin = index / baseBinSize;
+        auto binEnd = std::min((bin + 1) * baseBinSize, end);
+        auto &envelope = this->GetBin_(0, bin);
+
+        // A bin starts over with its first sample, which replaces the bin
+        // that used its place in the ring.
+        if (index % baseBinSize == 0)
+        {
+            envelope = Envelope{};
+        }
+
+        for (; index < binEnd; ++index)
+        {
+            envelope.Add(this->Get(index));
+        }
+    }
+}
+
+
+void PlotHistory::UpdateLevel_(size_t level, uint64_t begin, uint64_t end)
+{
+    auto shift = this->levels_[level].shift;
+    auto firstBin = begin >> shift;
+    auto lastBin = (end - 1) >> shift;
+
+    // The children of a bin are two bins of the level below.
+    auto firstChild = begin >> (shift - 1);
+    auto lastChild = (end - 1) >> (shift - 1);
+
+    for (auto bin = firstBin; bin <= lastBin; ++bin)
+    {
+        auto &envelope = this->GetBin_(level, bin);
+
+        if ((bin << shift) >= begin)
+        {
+            // All of this bin's samples are new.
+            envelope = Envelope{};
+        }
+
+        auto child = std::max(bin * 2, firstChild);
+        auto childEnd = std::min(bin * 2 + 1, lastChild);
+
+        for (; child <= childEnd; ++child)
+        {
+            envelope.Add(this->GetBin_(level - 1, child));
+        }
+    }
+}
+
+
+} // end namespace wxpex
@@ -0,0 +1,124 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+namespace wxpex
+{
+
+
+// The smallest and largest of a run of samples.
+struct Envelope
+{
+    float minimum = std::numeric_limits<float>::max();
+    float maximum = std::numeric_limits<float>::lowest();
+
+    bool IsEmpty() const
+    {
+        return this->minimum > this->maximum;
+    }
+
+    void Add(float sample)
+    {
+        this->minimum = (sample < this->minimum) ? sample : this->minimum;
+        this->maximum = (sample > this->maximum) ? sample : this->maximum;
+    }
+
+    void Add(const Envelope &other)
+    {
+        this->Add(other.minimum);
+        this->Add(other.maximum);
+    }
+};
+
+
+/**
+ ** The most recent samples of a stream, with a pyramid of min/max envelopes
+ ** for drawing any span of them at any zoom in time proportional to the
+ ** number of pixels.
+ **
+ ** Samples are numbered from 0 as they are appended, and the oldest are
+ ** forgotten once there are more than capacity.
+ **
+ ** Level 0 of the pyramid has the envelope of every run of baseBinSize
+ ** samples, and each level above it has bins twice as large. Every level is
+ ** a ring buffer covering the same samples, and appending updates only the
+ ** bins it touches.
+ **/
+class PlotHistory
+{
+public:
+    static constexpr size_t baseBinSize = 8;
+
+    PlotHistory(size_t capacity);
+
+    void Append(const float *samples, size_t count);
+
+    void Append(const std::vector<float> &samples);
+
+    void Clear();
+
+    size_t GetCapacity() const;
+
+    // The number of the oldest sample that is kept.
+    uint64_t GetBegin() const;
+
+    // One past the number of the newest sample.
+    uint64_t GetEnd() const;
+
+    size_t GetCount() const;
+
+    bool IsEmpty() const;
+
+    // index must be from GetBegin() to GetEnd() - 1.
+    float Get(uint64_t index) const;
+
+    size_t GetLevelCount() const;
+
+    size_t GetBinSize(size_t level) const;
+
+    /**
+     ** The exact envelope of the kept samples from first to last - 1, from
+     ** the largest bins that fit, and single samples at the ends.
+     **
+     ** Empty if no kept sample is in the range.
+     **/
+    Envelope GetEnvelope(uint64_t first, uint64_t last) const;
+
+    /**
+     ** Fills columns with the envelopes of consecutive runs of
+     ** samplesPerColumn samples, starting at first, one for each pixel column
+     ** of a plot.
+     **/
+    void GetColumns(
+        double first,
+        double samplesPerColumn,
+        std::vector<Envelope> &columns) const;
+
+private:
+    struct Level
+    {
+        size_t shift;
+        std::vector<Envelope> bins;
+    };
+
+    const Envelope & GetBin_(size_t level, uint64_t bin) const;
+
+    Envelope & GetBin_(size_t level, uint64_t bin);
+
+    void UpdateBase_(uint64_t begin, uint64_t end);
+
+    void UpdateLevel_(size_t level, uint64_t begin, uint64_t end);
+
+    size_t capacity_;
+    std::vector<float> samples_;
+    std::vector<Level> levels_;
+    uint64_t end_;
+};
+
+
+} // end namespace wxpex
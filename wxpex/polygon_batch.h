@@ -0,0 +1,256 @@
+#pragma once
+
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "wxpex/resource_cache.h"
+#include "wxpex/shape.h"
+
+
+namespace polygon
+{
+
+
+/**
+ ** The vertices of a regular polygon relative to its position, which depend
+ ** only on the side count, side length, and rotation of its Recipe.
+ **/
+struct Geometry
+{
+    std::vector<Point> vertices;
+    Bounds bounds;
+};
+
+
+/**
+ ** Recipes that differ only by position share their Geometry, so generating a
+ ** polygon from a cached recipe is a translation of its vertices.
+ **
+ ** Animated sizes or rotations produce a new key on every frame, so the cache
+ ** holds at most capacity geometries, discarding the least recently used.
+ **/
+class GeometryCache
+{
+public:
+    static constexpr size_t defaultCapacity = 1024;
+
+    GeometryCache(size_t capacity = defaultCapacity)
+        :
+        geometries_(capacity)
+    {
+
+    }
+
+    std::shared_ptr<const Geometry> Get(const Recipe &recipe)
+    {
+        auto key =
+            Key{recipe.sideCount, recipe.sideLength, recipe.rotation_deg};
+
+        return this->geometries_.Get(
+            key,
+            [&recipe]() -> std::shared_ptr<const Geometry>
+            {
+                auto vertices = recipe.GetVertices();
+                auto bounds = Bounds::FromPoints(vertices);
+
+                return std::make_shared<const Geometry>(
+                    Geometry{std::move(vertices), bounds});
+            });
+    }
+
+    Polygon MakePolygon(const Recipe &recipe)
+    {
+        return Polygon(this->Get(recipe)->vertices, recipe.position);
+    }
+
+    size_t GetCount() const
+    {
+        return this->geometries_.GetCount();
+    }
+
+    size_t GetCapacity() const
+    {
+        return this->geometries_.GetCapacity();
+    }
+
+    void Clear()
+    {
+        this->geometries_.Clear();
+    }
+
+private:
+    using Key = std::tuple<size_t, double, double>;
+
+    wxpex::LruCache<Key, std::shared_ptr<const Geometry>> geometries_;
+};
+
+
+struct Style
+{
+    tau::Rgba<uint8_t> color;
+    wxpex::Composition composition;
+
+    bool operator==(const Style &other) const
+    {
+        return this->color.red == other.color.red
+            && this->color.green == other.color.green
+            && this->color.blue == other.color.blue
+            && this->color.alpha == other.color.alpha
+            && this->composition == other.composition;
+    }
+};
+
+
+/**
+ ** Fills many polygons with one wxGraphicsPath per Style.
+ **
+ ** Polygons that share a style are filled together, with the winding rule so
+ ** that overlapping polygons do not cancel. Where polygons of the same
+ ** translucent style overlap, the color is applied once rather than once per
+ ** polygon.
+ **
+ ** Styles are drawn in the order they were first added, so polygons of
+ ** different styles are only layered correctly if the styles are added in
+ ** drawing order.
+ **/
+class PolygonBatch
+{
+public:
+    PolygonBatch()
+        :
+        buckets_(),
+        geometryCache_(),
+        count_(0)
+    {
+
+    }
+
+    void Add(const Polygon &polygon, const Style &style)
+    {
+        this->GetBucket_(style).polygons.push_back(polygon);
+        ++this->count_;
+    }
+
+    void Add(const Recipe &recipe, const Style &style)
+    {
+        this->Add(this->geometryCache_.MakePolygon(recipe), style);
+    }
+
+    void Add(const Recipe &recipe, const Color &color)
+    {
+        this->Add(recipe, Style{color.color, color.compositionMode});
+    }
+
+    size_t GetCount() const
+    {
+        return this->count_;
+    }
+
+    size_t GetStyleCount() const
+    {
+        return this->buckets_.size();
+    }
+
+    GeometryCache & GetGeometryCache()
+    {
+        return this->geometryCache_;
+    }
+
+    // Removes the polygons, but keeps the cached geometry, which is bounded by
+    // the capacity of the GeometryCache.
+    void Clear()
+    {
+        this->buckets_.clear();
+        this->count_ = 0;
+    }
+
+    /**
+     ** Draws the polygons that intersect viewport, in the coordinates of the
+     ** context.
+     **
+     ** @return The number of polygons drawn.
+     **/
+    size_t Draw(wxpex::GraphicsContext &context, const Bounds &viewport) const
+    {
+        size_t drawnCount = 0;
+
+        for (auto &bucket: this->buckets_)
+        {
+            auto path = context->CreatePath();
+            size_t pathCount = 0;
+
+            for (auto &polygon: bucket.polygons)
+            {
+                if (polygon.GetBounds().Intersects(viewport))
+                {
+                    polygon.CreatePath(path);
+                    ++pathCount;
+                }
+            }
+
+            if (pathCount == 0)
+            {
+                continue;
+            }
+
+            context.SetComposition(bucket.style.composition);
+
+            context->SetBrush(
+                wxBrush(wxpex::ToWxColour(bucket.style.color)));
+
+            context->FillPath(path, wxWINDING_RULE);
+            drawnCount += pathCount;
+        }
+
+        return drawnCount;
+    }
+
+    // Draws the polygons that intersect the clipping region of the context.
+    size_t Draw(wxpex::GraphicsContext &context) const
+    {
+        double x;
+        double y;
+        double width;
+        double height;
+
+        context->GetClipBox(&x, &y, &width, &height);
+
+        return this->Draw(context, Bounds{x, y, x + width, y + height});
+    }
+
+private:
+    struct Bucket_
+    {
+        Style style;
+        std::vector<Polygon> polygons;
+    };
+
+    Bucket_ & GetBucket_(const Style &style)
+    {
+        // There are usually few styles, and the most recent is the most
+        // likely to be used again.
+        for (
+            auto it = this->buckets_.rbegin();
+            it != this->buckets_.rend();
+            ++it)
+        {
+            if (it->style == style)
+            {
+                return *it;
+            }
+        }
+
+        this->buckets_.push_back(Bucket_{style, {}});
+
+        return this->buckets_.back();
+    }
+
+    std::vector<Bucket_> buckets_;
+    GeometryCache geometryCache_;
+    size_t count_;
+};
+
+
+} // end namespace polygon
@@ -0,0 +1,140 @@
+#include "wxpex/refresh_timer.h"
+
+#include <map>
+#include <algorithm>
+
+
+namespace wxpex
+{
+
+
+RefreshTimer::RefreshTimer(int interval_ms)
+    :
+    interval_ms_(std::max(1, interval_ms)),
+    timer_(this),
+    pending_(),
+    ticking_()
+{
+    this->Bind(wxEVT_TIMER, &RefreshTimer::OnTimer_, this);
+}
+
+
+RefreshTimer::~RefreshTimer()
+{
+    this->timer_.Stop();
+}
+
+
+std::shared_ptr<RefreshTimer> RefreshTimer::Acquire(int interval_ms)
+{
+    static std::map<int, std::weak_ptr<RefreshTimer>> timerByInterval;
+
+    // Intervals that the constructor raises to the same value share a timer.
+    interval_ms = std::max(1, interval_ms);
+
+    auto &weak = timerByInterval[interval_ms];
+    auto result = weak.lock();
+
+    if (!result)
+    {
+        result = std::make_shared<RefreshTimer>(interval_ms);
+        weak = result;
+    }
+
+    return result;
+}
+
+
+int RefreshTimer::GetInterval_ms() const
+{
+    return this->interval_ms_;
+}
+
+
+void RefreshTimer::Request(void *subscriber, const Callback &callback)
+{
+    auto found = std::find_if(
+        std::begin(this->pending_),
+        std::end(this->pending_),
+        [subscriber](const Pending_ &pending) -> bool
+        {
+            return pending.subscriber == subscriber;
+        });
+
+    if (found != std::end(this->pending_))
+    {
+        found->callback = callback;
+        return;
+    }
+
+    this->pending_.push_back({subscriber, callback});
+
+    if (!this->timer_.IsRunning())
+    {
+        this->timer_.Start(this->interval_ms_, wxTIMER_CONTINUOUS);
+    }
+}
+
+
+void RefreshTimer::Cancel(void *subscriber)
+{
+    auto isSubscriber = [subscriber](const Pending_ &pending) -> bool
+    {
+        return pending.subscriber == subscriber;
+    };
+
+    this->pending_.erase(
+        std::remove_if(
+            std::begin(this->pending_),
+            std::end(this->pending_),
+            isSubscriber),
+        std::end(this->pending_));
+
+    // A subscriber may be destroyed by a callback earlier in the same tick.
+    for (auto &ticking: this->ticking_)
+    {
+        if (isSubscriber(ticking))
+        {
+            ticking.subscriber = nullptr;
+        }
+    }
+}
+
+
+void RefreshTimer::OnTimer_(wxTimerEvent &)
+{
+    if (this->pending_.empty())
+    {
+        // Nothing was requested since the last tick.
+        this->timer_.Stop();
+        return;
+    }
+
+    // A callback may destroy the last subscriber holding this timer. Keep it
+    // alive until the tick is done.
+    auto keepAlive = this->weak_from_this().lock();
+
+    // Callbacks may request another refresh, which will be applied on the
+    // next tick.
+    this->ticking_.swap(this->pending_);
+
+    for (size_t i = 0; i < this->ticking_.size(); ++i)
+    {
+        if (this->ticking_[i].subscriber)
+        {
+            this->ticking_[i].callback();
+        }
+    }
+
+    this->ticking_.clear();
+
+    if (keepAlive && keepAlive.use_count() == 1 && wxTheApp)
+    {
+        // Release the last reference after this event has been processed,
+        // instead of destroying the handler from within its own handler.
+        wxTheApp->CallAfter([keepAlive]() -> void {});
+    }
+}
+
+
+} // end namespace wxpex
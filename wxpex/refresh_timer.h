@@ -0,0 +1,75 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "wxpex/wxshim.h"
+
+
+namespace wxpex
+{
+
+
+/**
+ ** A timer shared by every readout that refreshes at the same rate, so that
+ ** rate-limited widgets update together on the same tick.
+ **
+ ** The timer only runs while refreshes are pending.
+ **/
+class RefreshTimer
+    :
+    public wxEvtHandler,
+    public std::enable_shared_from_this<RefreshTimer>
+{
+public:
+    using Callback = std::function<void()>;
+
+    RefreshTimer(int interval_ms);
+
+    ~RefreshTimer();
+
+    RefreshTimer(const RefreshTimer &) = delete;
+    RefreshTimer & operator=(const RefreshTimer &) = delete;
+
+    /**
+     ** Returns the timer shared by every subscriber with the same interval,
+     ** after raising it to at least 1 ms. The timer is destroyed when the
+     ** last subscriber releases it, which may happen during its own tick.
+     **
+     ** Must be called from the wx event loop thread.
+     **/
+    static std::shared_ptr<RefreshTimer> Acquire(int interval_ms);
+
+    int GetInterval_ms() const;
+
+    /**
+     ** Schedule callback to run on the next tick.
+     ** Each subscriber has at most one pending callback; requesting again
+     ** before the tick replaces it.
+     **/
+    void Request(void *subscriber, const Callback &callback);
+
+    void Cancel(void *subscriber);
+
+private:
+    void OnTimer_(wxTimerEvent &);
+
+    struct Pending_
+    {
+        void *subscriber;
+        Callback callback;
+    };
+
+    int interval_ms_;
+    wxTimer timer_;
+
+    // Pending refreshes are applied in the order they were requested.
+    std::vector<Pending_> pending_;
+
+    // The refreshes being applied by the current tick.
+    std::vector<Pending_> ticking_;
+};
+
+
+} // end namespace wxpex
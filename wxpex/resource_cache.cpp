@@ -0,0 +1,274 @@
+#include "wxpex/resource_cache.h"
+
+#include <memory>
+
+WXSHIM_PUSH_IGNORES
+#include <wx/module.h>
+WXSHIM_POP_IGNORES
+
+
+namespace wxpex
+{
+
+
+using GraphicsResourceCaches =
+    std::map<wxGraphicsRenderer *, std::unique_ptr<GraphicsResourceCache>>;
+
+
+// Allocated on first use and deleted by GraphicsResourceModule. A static map
+// would be destroyed after wx has cleaned up the renderers.
+static GraphicsResourceCaches *graphicsResourceCaches = nullptr;
+
+
+class GraphicsResourceModule: public wxModule
+{
+public:
+    GraphicsResourceModule()
+    {
+#if defined(__WXMSW__) && wxUSE_GRAPHICS_GDIPLUS
+        // Release the cached GDI+ objects before GDI+ is shut down.
+        this->AddDependency("wxGDIPlusRendererModule");
+#endif
+    }
+
+    bool OnInit() override
+    {
+        return true;
+    }
+
+    void OnExit() override
+    {
+        GraphicsResourceCache::ReleaseAll();
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(GraphicsResourceModule);
+};
+
+
+wxIMPLEMENT_DYNAMIC_CLASS(GraphicsResourceModule, wxModule);
+
+
+GraphicsResourceCache::GraphicsResourceCache(
+    wxGraphicsRenderer *renderer,
+    size_t capacity)
+    :
+    renderer_(renderer),
+    pens_(capacity),
+    brushes_(capacity),
+    linearGradients_(capacity),
+    radialGradients_(capacity),
+    fonts_(capacity)
+{
+    if (!renderer)
+    {
+        throw GraphicsError("GraphicsResourceCache requires a renderer");
+    }
+}
+
+
+GraphicsResourceCache & GraphicsResourceCache::Get(
+    wxGraphicsRenderer *renderer)
+{
+    if (!graphicsResourceCaches)
+    {
+        graphicsResourceCaches = new GraphicsResourceCaches();
+    }
+
+    auto &cache = (*graphicsResourceCaches)[renderer];
+
+    if (!cache)
+    {
+        cache = std::make_unique<GraphicsResourceCache>(renderer);
+    }
+
+    return *cache;
+}
+
+
+GraphicsResourceCache & GraphicsResourceCache::Get(GraphicsContext &context)
+{
+    return Get(context->GetRenderer());
+}
+
+
+void GraphicsResourceCache::Release(wxGraphicsRenderer *renderer)
+{
+    if (graphicsResourceCaches)
+    {
+        graphicsResourceCaches->erase(renderer);
+    }
+}
+
+
+void GraphicsResourceCache::ReleaseAll()
+{
+    delete graphicsResourceCaches;
+    graphicsResourceCaches = nullptr;
+}
+
+
+wxGraphicsRenderer * GraphicsResourceCache::GetRenderer() const
+{
+    return this->renderer_;
+}
+
+
+wxGraphicsPen GraphicsResourceCache::GetPen(
+    const wxColour &color,
+    double width,
+    PenStyle style,
+    PenCap cap,
+    PenJoin join)
+{
+    return this->pens_.Get(
+        PenKey{color.GetRGBA(), width, style, cap, join},
+        [&]()
+        {
+            return this->renderer_->CreatePen(
+                wxGraphicsPenInfo(
+                    color,
+                    width,
+                    static_cast<wxPenStyle>(style))
+                .Cap(static_cast<wxPenCap>(cap))
+                .Join(static_cast<wxPenJoin>(join)));
+        });
+}
+
+
+wxGraphicsBrush GraphicsResourceCache::GetBrush(
+    const wxColour &color,
+    BrushStyle style)
+{
+    return this->brushes_.Get(
+        BrushKey{color.GetRGBA(), style},
+        [&]()
+        {
+            return this->renderer_->CreateBrush(
+                wxBrush(color, static_cast<wxBrushStyle>(style)));
+        });
+}
+
+
+wxGraphicsBrush GraphicsResourceCache::GetLinearGradientBrush(
+    double x1,
+    double y1,
+    double x2,
+    double y2,
+    const wxGraphicsGradientStops &stops)
+{
+    return this->linearGradients_.Get(
+        LinearGradientKey{x1, y1, x2, y2, MakeStops_(stops)},
+        [&]()
+        {
+            return this->renderer_->CreateLinearGradientBrush(
+                x1,
+                y1,
+                x2,
+                y2,
+                stops);
+        });
+}
+
+
+wxGraphicsBrush GraphicsResourceCache::GetRadialGradientBrush(
+    double startX,
+    double startY,
+    double endX,
+    double endY,
+    double radius,
+    const wxGraphicsGradientStops &stops)
+{
+    return this->radialGradients_.Get(
+        RadialGradientKey{
+            startX,
+            startY,
+            endX,
+            endY,
+            radius,
+            MakeStops_(stops)},
+        [&]()
+        {
+            return this->renderer_->CreateRadialGradientBrush(
+                startX,
+                startY,
+                endX,
+                endY,
+                radius,
+                stops);
+        });
+}
+
+
+wxGraphicsFont GraphicsResourceCache::GetFont(
+    const wxFont &font,
+    const wxColour &color)
+{
+    return this->fonts_.Get(
+        FontKey{font.GetNativeFontInfoDesc().ToStdString(), color.GetRGBA()},
+        [&]()
+        {
+            return this->renderer_->CreateFont(font, color);
+        });
+}
+
+
+size_t GraphicsResourceCache::GetCount() const
+{
+    return this->pens_.GetCount()
+        + this->brushes_.GetCount()
+        + this->linearGradients_.GetCount()
+        + this->radialGradients_.GetCount()
+        + this->fonts_.GetCount();
+}
+
+
+CacheStatistics GraphicsResourceCache::GetStatistics() const
+{
+    auto result = this->pens_.GetStatistics();
+    result += this->brushes_.GetStatistics();
+    result += this->linearGradients_.GetStatistics();
+    result += this->radialGradients_.GetStatistics();
+    result += this->fonts_.GetStatistics();
+
+    return result;
+}
+
+
+void GraphicsResourceCache::ResetStatistics()
+{
+    this->pens_.ResetStatistics();
+    this->brushes_.ResetStatistics();
+    this->linearGradients_.ResetStatistics();
+    this->radialGradients_.ResetStatistics();
+    this->fonts_.ResetStatistics();
+}
+
+
+void GraphicsResourceCache::Clear()
+{
+    this->pens_.Clear();
+    this->brushes_.Clear();
+    this->linearGradients_.Clear();
+    this->radialGradients_.Clear();
+    this->fonts_.Clear();
+}
+
+
+GraphicsResourceCache::Stops GraphicsResourceCache::MakeStops_(
+    const wxGraphicsGradientStops &stops)
+{
+    Stops result;
+    result.reserve(stops.GetCount());
+
+    for (size_t i = 0; i < stops.GetCount(); ++i)
+    {
+        auto stop = stops.Item(static_cast<unsigned>(i));
+        result.emplace_back(stop.GetPosition(), stop.GetColour().GetRGBA());
+    }
+
+    return result;
+}
+
+
+} // end namespace wxpex
@@ -0,0 +1,258 @@
+#pragma once
+
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "wxpex/ignores.h"
+
+WXSHIM_PUSH_IGNORES
+#include <wx/graphics.h>
+WXSHIM_POP_IGNORES
+
+#include "wxpex/graphics.h"
+
+
+namespace wxpex
+{
+
+
+struct CacheStatistics
+{
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+
+    CacheStatistics & operator+=(const CacheStatistics &other)
+    {
+        this->hits += other.hits;
+        this->misses += other.misses;
+        this->evictions += other.evictions;
+
+        return *this;
+    }
+
+    // The fraction of lookups that found an existing value.
+    double GetHitRate() const
+    {
+        auto lookups = this->hits + this->misses;
+
+        if (lookups == 0)
+        {
+            return 0.0;
+        }
+
+        return static_cast<double>(this->hits)
+            / static_cast<double>(lookups);
+    }
+};
+
+
+/**
+ ** Holds at most capacity values, discarding the least recently used value
+ ** to make room for a new one.
+ **
+ ** Key must be ordered by operator<.
+ **/
+template<typename Key, typename Value>
+class LruCache
+{
+public:
+    LruCache(size_t capacity)
+        :
+        capacity_(capacity),
+        values_(),
+        index_(),
+        statistics_{0, 0, 0}
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("capacity must be at least 1");
+        }
+    }
+
+    /**
+     ** Returns the value stored for key, or the value returned by create,
+     ** which is stored for the next lookup.
+     **/
+    template<typename Create>
+    const Value & Get(const Key &key, Create &&create)
+    {
+        auto found = this->index_.find(key);
+
+        if (found != this->index_.end())
+        {
+            ++this->statistics_.hits;
+
+            // Move the entry to the front, marking it most recently used.
+            this->values_.splice(
+                this->values_.begin(),
+                this->values_,
+                found->second);
+
+            return found->second->second;
+        }
+
+        ++this->statistics_.misses;
+
+        if (this->values_.size() == this->capacity_)
+        {
+            this->index_.erase(this->values_.back().first);
+            this->values_.pop_back();
+            ++this->statistics_.evictions;
+        }
+
+        this->values_.emplace_front(key, create());
+        this->index_.emplace(key, this->values_.begin());
+
+        return this->values_.front().second;
+    }
+
+    bool Contains(const Key &key) const
+    {
+        return this->index_.count(key) > 0;
+    }
+
+    size_t GetCount() const
+    {
+        return this->values_.size();
+    }
+
+    size_t GetCapacity() const
+    {
+        return this->capacity_;
+    }
+
+    const CacheStatistics & GetStatistics() const
+    {
+        return this->statistics_;
+    }
+
+    void ResetStatistics()
+    {
+        this->statistics_ = {0, 0, 0};
+    }
+
+    void Clear()
+    {
+        this->index_.clear();
+        this->values_.clear();
+    }
+
+private:
+    using Values = std::list<std::pair<Key, Value>>;
+
+    size_t capacity_;
+    Values values_;
+    std::map<Key, typename Values::iterator> index_;
+    CacheStatistics statistics_;
+};
+
+
+/**
+ ** Reuses the wxGraphicsPen, wxGraphicsBrush, and wxGraphicsFont objects
+ ** created by one wxGraphicsRenderer, so that widgets repainting with the
+ ** same parameters do not create native objects on every paint.
+ **
+ ** Each kind of object is held in its own LruCache.
+ **
+ ** The shared caches returned by Get are destroyed by a wxModule when wx
+ ** shuts down, before the renderers that created their objects.
+ **
+ ** Must only be used from the wx event loop thread.
+ **/
+class GraphicsResourceCache
+{
+public:
+    static constexpr size_t defaultCapacity = 128;
+
+    GraphicsResourceCache(
+        wxGraphicsRenderer *renderer,
+        size_t capacity = defaultCapacity);
+
+    // The shared cache for renderer, created on first use.
+    static GraphicsResourceCache & Get(wxGraphicsRenderer *renderer);
+
+    // The shared cache for the renderer of context.
+    static GraphicsResourceCache & Get(GraphicsContext &context);
+
+    // Destroys the shared cache for renderer, if there is one.
+    // Call before destroying a renderer that was passed to Get.
+    static void Release(wxGraphicsRenderer *renderer);
+
+    // Destroys all of the shared caches.
+    static void ReleaseAll();
+
+    wxGraphicsRenderer * GetRenderer() const;
+
+    wxGraphicsPen GetPen(
+        const wxColour &color,
+        double width = 1.0,
+        PenStyle style = PenStyle::solid,
+        PenCap cap = PenCap::round,
+        PenJoin join = PenJoin::round);
+
+    wxGraphicsBrush GetBrush(
+        const wxColour &color,
+        BrushStyle style = BrushStyle::solid);
+
+    wxGraphicsBrush GetLinearGradientBrush(
+        double x1,
+        double y1,
+        double x2,
+        double y2,
+        const wxGraphicsGradientStops &stops);
+
+    wxGraphicsBrush GetRadialGradientBrush(
+        double startX,
+        double startY,
+        double endX,
+        double endY,
+        double radius,
+        const wxGraphicsGradientStops &stops);
+
+    wxGraphicsFont GetFont(const wxFont &font, const wxColour &color);
+
+    // The total number of cached objects of all kinds.
+    size_t GetCount() const;
+
+    // The combined statistics of all kinds.
+    CacheStatistics GetStatistics() const;
+
+    void ResetStatistics();
+
+    void Clear();
+
+private:
+    // The position and RGBA color of each stop.
+    using Stops = std::vector<std::pair<float, uint32_t>>;
+
+    static Stops MakeStops_(const wxGraphicsGradientStops &stops);
+
+    using PenKey = std::tuple<uint32_t, double, PenStyle, PenCap, PenJoin>;
+    using BrushKey = std::tuple<uint32_t, BrushStyle>;
+
+    using LinearGradientKey =
+        std::tuple<double, double, double, double, Stops>;
+
+    using RadialGradientKey =
+        std::tuple<double, double, double, double, double, Stops>;
+
+    using FontKey = std::tuple<std::string, uint32_t>;
+
+    wxGraphicsRenderer *renderer_;
+    LruCache<PenKey, wxGraphicsPen> pens_;
+    LruCache<BrushKey, wxGraphicsBrush> brushes_;
+    LruCache<LinearGradientKey, wxGraphicsBrush> linearGradients_;
+    LruCache<RadialGradientKey, wxGraphicsBrush> radialGradients_;
+    LruCache<FontKey, wxGraphicsFont> fonts_;
+};
+
+
+} // end namespace wxpex
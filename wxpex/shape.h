@@ -1,8 +1,20 @@
 #pragma once
 
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <list>
+#include <optional>
+#include <vector>
 #include <fields/fields.h>
+#include <pex/group.h>
+#include <pex/endpoint.h>
+#include <pex/range.h>
+#include <tau/angles.h>
+#include <tau/vector2d.h>
 #include "wxpex/color.h"
 #include "wxpex/point.h"
 #include "wxpex/graphics.h"
@@ -12,6 +24,67 @@ namespace polygon
 {
 
 
+using Point = tau::Point2d<double>;
+
+
+struct Bounds
+{
+    double left;
+    double top;
+    double right;
+    double bottom;
+
+    static Bounds FromPoints(const std::vector<Point> &points)
+    {
+        if (points.empty())
+        {
+            return {0.0, 0.0, 0.0, 0.0};
+        }
+
+        Bounds result{
+            points.front().x,
+            points.front().y,
+            points.front().x,
+            points.front().y};
+
+        for (auto &point: points)
+        {
+            result.left = std::min(result.left, point.x);
+            result.top = std::min(result.top, point.y);
+            result.right = std::max(result.right, point.x);
+            result.bottom = std::max(result.bottom, point.y);
+        }
+
+        return result;
+    }
+
+    Bounds Translated(const Point &offset) const
+    {
+        return {
+            this->left + offset.x,
+            this->top + offset.y,
+            this->right + offset.x,
+            this->bottom + offset.y};
+    }
+
+    bool Contains(const Point &point) const
+    {
+        return point.x >= this->left
+            && point.x <= this->right
+            && point.y >= this->top
+            && point.y <= this->bottom;
+    }
+
+    bool Intersects(const Bounds &other) const
+    {
+        return this->left <= other.right
+            && other.left <= this->right
+            && this->top <= other.bottom
+            && other.top <= this->bottom;
+    }
+};
+
+
 template<typename T>
 struct RecipeFields
 {
@@ -23,14 +96,16 @@ struct RecipeFields
 };
 
 
-
 template<template<typename> typename T>
 struct RecipeTemplate
 {
     T<pex::MakeRange<size_t, pex::Limit<3>, pex::Limit<1024>>> sideCount;
     T<double> sideLength;
-    T<tau::Point2d<double> position;
-    T<pex::MakeRange<double, pex::Limit<-180>, pex::Limit<180>> rotation_deg;
+    T<Point> position;
+    T<pex::MakeRange<double, pex::Limit<-180>, pex::Limit<180>>> rotation_deg;
+
+    static constexpr auto fields = RecipeFields<RecipeTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Recipe";
 };
 
 
@@ -40,24 +115,68 @@ struct Recipe: public RecipeTemplate<pex::Identity>
         :
         RecipeTemplate<pex::Identity>{
             3,
-            100,
+            100.0,
             {},
-            {}};
+            0.0}
+    {
+
+    }
+
+    static Recipe Default()
+    {
+        return {};
+    }
+
+    double GetWedgeAngle_rad() const
+    {
+        return tau::ToRadians(360.0 / static_cast<double>(this->sideCount));
     }
 
-    double GetWedgeAngle_rad()
+    // The distance from the center to each vertex.
+    double GetRadius() const
     {
-        return tau::Angles<double>::tau / double(this->sideCount);
+        return this->sideLength
+            / (2.0 * std::sin(this->GetWedgeAngle_rad() / 2.0));
     }
 
-    double GetRadius(double halfWedgeAngle_rad) const
+    /**
+     ** The vertices of the regular polygon described by this recipe, relative
+     ** to its position.
+     **
+     ** Vertices are ordered by increasing angle, which is clockwise on screen.
+     ** Each vertex is computed directly from its index, so no error
+     ** accumulates as the side count grows.
+     **/
+    std::vector<Point> GetVertices() const
     {
-        return this->sideLength / (2 * std::tan(halfWedgeAngle_rad));
+        auto wedgeAngle_rad = this->GetWedgeAngle_rad();
+        auto radius = this->GetRadius();
+
+        // With no rotation, the first side is horizontal along the top.
+        auto startAngle_rad =
+            tau::ToRadians(this->rotation_deg - 90.0) - wedgeAngle_rad / 2.0;
+
+        // Iterations are independent, so they may be vectorized.
+        std::vector<Point> result(this->sideCount);
+
+        for (size_t i = 0; i < this->sideCount; ++i)
+        {
+            auto angle_rad =
+                startAngle_rad + static_cast<double>(i) * wedgeAngle_rad;
+
+            result[i].x = radius * std::cos(angle_rad);
+            result[i].y = radius * std::sin(angle_rad);
+        }
+
+        return result;
     }
 };
 
 
-using RecipeGroup = pex::Group<RecipeFields, RecipeTemplate, Recipe>;
+using RecipeGroup =
+    pex::Group<RecipeFields, RecipeTemplate, pex::PlainT<Recipe>>;
+
+using RecipeModel = typename RecipeGroup::Model;
 using RecipeControl = typename RecipeGroup::Control;
 
 
@@ -66,84 +185,177 @@ class Polygon
 public:
     Polygon()
         :
-        points_{}
+        points_{},
+        bounds_{0.0, 0.0, 0.0, 0.0}
     {
 
     }
 
     Polygon(const Recipe &recipe)
         :
-        points_()
+        Polygon(recipe.GetVertices(), recipe.position)
     {
-        double wedgeAngle_rad = recipe.GetWedgeAngle_rad();
-        double halfWedgeAngle_rad = wedgeAngle_rad / 2.0;
-        double wedgeAngle_deg = tau::ToDegrees(wedgeAngle_rad);
-
-        double radius = recipe.GetRadius(halfWedgeAngle_rad);
-        double startAngle_deg = (wedgeAngle_deg / 2.0) + recipe.rotation_deg;
-        tau::Vector2d<double> toStart{{radius, 0.0}};
-        auto start = center + toStart.Rotate(startAngle_deg);
-        this->points_.push_back(start);
 
-        tau::Vector2d<double> side{{sideLength, 0.0}};
-        side = side.Rotate(180 + recipe.rotation_deg);
-        auto currentPoint = point;
+    }
 
-        // Do not add the starting point twice
-        sideCount -= 1;
+    /**
+     ** @param vertices The vertices of a convex polygon relative to position,
+     ** ordered clockwise on screen.
+     **/
+    Polygon(const std::vector<Point> &vertices, const Point &position)
+        :
+        points_(),
+        bounds_()
+    {
+        this->points_.reserve(vertices.size());
 
-        while (sideCount--)
+        for (auto &vertex: vertices)
         {
-            currentPoint = currentPoint + side;
-            this->points_.push_back(currentPoint);
-            side.Rotate(wedgeAngle_deg);
+            this->points_.emplace_back(
+                vertex.x + position.x,
+                vertex.y + position.y);
         }
+
+        this->bounds_ = Bounds::FromPoints(this->points_);
+    }
+
+    const std::vector<Point> & GetPoints() const
+    {
+        return this->points_;
+    }
+
+    const Bounds & GetBounds() const
+    {
+        return this->bounds_;
     }
 
     /*
      * @return true for points that fall inside or on the line.
      */
-    bool Contains(const tau::Point2d<double> &point)
+    bool Contains(const Point &point) const
     {
-        if (this->points_.size() < 2)
+        if (this->points_.size() < 3)
         {
             return false;
         }
 
-        // Points are added clock-wise, so point will be on the right of every
-        // segment if it is contained by the polygon.
-        for (size_t start: jive::Range<size_t>(0, this->points_.size() - 1))
+        if (!this->bounds_.Contains(point))
         {
-            const auto &startPoint = this->points_[start];
-            auto end = start + 1;
+            return false;
+        }
 
-            auto segment =
-                tau::Vector2d<double>(
-                    this->points_[start],
-                    this->points_[end]);
+        // Points are added clockwise on screen, with y increasing downward,
+        // so a contained point is never on the left of a segment.
+        auto previous = this->points_.back();
 
-            auto test = tau::Vector2d<double>(startPoint, point);
+        for (auto &current: this->points_)
+        {
+            auto segmentX = current.x - previous.x;
+            auto segmentY = current.y - previous.y;
+            auto testX = point.x - previous.x;
+            auto testY = point.y - previous.y;
 
-            if (test.Cross(segment) < 0.0)
+            if (segmentX * testY - segmentY * testX < 0.0)
             {
-                // point is on the left
                 return false;
             }
+
+            previous = current;
         }
 
-        // Check the last segment
-        auto segment = tau::Vector2d<double>(
-            this->points_.back(),
-            this->points_.front());
+        return true;
+    }
 
-        auto test = tau::Vector2d<double>(
-            this->points_.back(),
-            point);
+    // One bit per point, least significant first, 64 points per word.
+    using Mask = std::vector<uint64_t>;
 
-        return test.Cross(segment) >= 0.0;
+    static bool IsSet(const Mask &mask, size_t index)
+    {
+        return (mask[index / 64] >> (index % 64)) & 1u;
     }
 
-    void CreatePath(wxGraphicsPath &path)
+    /**
+     ** Tests many points at once, with the same result as Contains for each.
+     **
+     ** The vertices and the points are split into separate x and y arrays,
+     ** and each block of 64 points is tested against one edge at a time. The
+     ** inner loops are branch-free over contiguous doubles, so the compiler
+     ** can vectorize them.
+     **/
+    Mask ContainsMany(const std::vector<Point> &points) const
+    {
+        Mask result((points.size() + 63) / 64, 0);
+
+        if (this->points_.size() < 3)
+        {
+            return result;
+        }
+
+        auto edgeCount = this->points_.size();
+        std::vector<double> startX(edgeCount);
+        std::vector<double> startY(edgeCount);
+        std::vector<double> segmentX(edgeCount);
+        std::vector<double> segmentY(edgeCount);
+
+        auto previous = this->points_.back();
+
+        for (size_t i = 0; i < edgeCount; ++i)
+        {
+            auto &current = this->points_[i];
+            startX[i] = previous.x;
+            startY[i] = previous.y;
+            segmentX[i] = current.x - previous.x;
+            segmentY[i] = current.y - previous.y;
+            previous = current;
+        }
+
+        static constexpr size_t blockSize = 64;
+        std::array<double, blockSize> x;
+        std::array<double, blockSize> y;
+        std::array<uint8_t, blockSize> inside;
+
+        for (size_t first = 0; first < points.size(); first += blockSize)
+        {
+            auto count = std::min(blockSize, points.size() - first);
+
+            for (size_t j = 0; j < count; ++j)
+            {
+                x[j] = points[first + j].x;
+                y[j] = points[first + j].y;
+                inside[j] = this->bounds_.Contains(points[first + j]);
+            }
+
+            for (size_t i = 0; i < edgeCount; ++i)
+            {
+                auto edgeStartX = startX[i];
+                auto edgeStartY = startY[i];
+                auto edgeX = segmentX[i];
+                auto edgeY = segmentY[i];
+
+                for (size_t j = 0; j < count; ++j)
+                {
+                    auto cross = edgeX * (y[j] - edgeStartY)
+                        - edgeY * (x[j] - edgeStartX);
+
+                    inside[j] &= static_cast<uint8_t>(cross >= 0.0);
+                }
+            }
+
+            uint64_t word = 0;
+
+            for (size_t j = 0; j < count; ++j)
+            {
+                word |= static_cast<uint64_t>(inside[j]) << j;
+            }
+
+            result[first / blockSize] = word;
+        }
+
+        return result;
+    }
+
+    // Adds the polygon to path as a closed subpath.
+    void CreatePath(wxGraphicsPath &path) const
     {
         if (this->points_.empty())
         {
@@ -151,7 +363,6 @@ public:
         }
 
         auto point = this->points_.begin();
-        // auto start = *point;
         path.MoveToPoint(point->x, point->y);
 
         while (++point != this->points_.end())
@@ -159,13 +370,12 @@ public:
             path.AddLineToPoint(point->x, point->y);
         }
 
-        // Close the path.
-        // path.AddLineToPoint(start.x, start.y);
-        path.CloseSubPath();
+        path.CloseSubpath();
     }
 
 private:
-    std::vector<tau::Point2d<double>> points_;
+    std::vector<Point> points_;
+    Bounds bounds_;
 };
 
 
@@ -182,11 +392,33 @@ template<template<typename> typename T>
 struct ColorTemplate
 {
     T<tau::Rgba<uint8_t>> color;
-    T<pex::MakeSelect<CompositionSelect>> compositionMode;
+    T<wxpex::CompositionSelect> compositionMode;
+
+    static constexpr auto fields = ColorFields<ColorTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Color";
 };
 
 
-using ColorGroup = pex::Group<ColorFields, ColorTemplate>;
+struct Color: public ColorTemplate<pex::Identity>
+{
+    Color()
+        :
+        ColorTemplate<pex::Identity>{
+            {{0, 0, 255, 255}},
+            wxpex::Composition::over}
+    {
+
+    }
+
+    static Color Default()
+    {
+        return {};
+    }
+};
+
+
+using ColorGroup = pex::Group<ColorFields, ColorTemplate, pex::PlainT<Color>>;
+using ColorModel = typename ColorGroup::Model;
 using ColorControl = typename ColorGroup::Control;
 
 
@@ -204,6 +436,9 @@ struct DrawTemplate
 {
     T<RecipeGroup> recipe;
     T<ColorGroup> color;
+
+    static constexpr auto fields = DrawFields<DrawTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Draw";
 };
 
 
@@ -212,25 +447,39 @@ using SettingsModel = typename SettingsGroup::Model;
 using SettingsControl = typename SettingsGroup::Control;
 
 
+inline void FillPolygon(
+    wxpex::GraphicsContext &graphics,
+    const Polygon &polygon,
+    const Color &color)
+{
+    graphics.SetComposition(color.compositionMode);
+    graphics->SetBrush(wxBrush(wxpex::ToWxColour(color.color)));
+    auto path = graphics->CreatePath();
+    polygon.CreatePath(path);
+    graphics->FillPath(path);
+}
+
+
 class DrawControl
 {
 public:
+    static constexpr auto observerName = "polygon::DrawControl";
+
     DrawControl(const SettingsControl &settings)
         :
-        recipe_(USE_REGISTER_PEX_NAME(this, "DrawControl"), settings.recipe),
+        recipe_(
+            USE_REGISTER_PEX_NAME(this, "DrawControl"),
+            settings.recipe,
+            &DrawControl::OnRecipe_),
         color_(settings.color),
         polygon_(this->recipe_.Get())
     {
-        this->recipe_.Connect(&DrawControl::OnRecipe_);
+
     }
 
-    void Draw(GraphicsContext &graphics)
+    void Draw(wxpex::GraphicsContext &graphics)
     {
-        graphics->SetCompositionMode(this->color_.compositionMode.Get());
-        graphics->SetBrush(wxBrush(ToWxColour(this->color_.color.Get())));
-        auto path = graphics->CreatePath();
-        this->polygon_.CreatePath(path);
-        graphicsContext->FillPath(path);
+        FillPolygon(graphics, this->polygon_, this->color_.Get());
     }
 
 private:
@@ -240,7 +489,7 @@ private:
     }
 
 private:
-    pex::Endpoint<Draw, RecipeControl> recipe_;
+    pex::Endpoint<DrawControl, RecipeControl> recipe_;
     ColorControl color_;
     Polygon polygon_;
 };
@@ -248,26 +497,47 @@ private:
 
 class DrawModel
 {
-    RecipeModel recipe;
-    ColorModel color;
-    Polygon polygon;
+public:
+    static constexpr auto observerName = "polygon::DrawModel";
 
-publc:
     DrawModel()
         :
-        recipe(Recipe::Default()),
-        color(Color::Default()),
-        polygon(this->recipe.Get()),
-        recipeEndpoint_(this, this->recipe, &DrawModel::OnRecipe_)
+        recipe_(),
+        color_(),
+        polygon_(this->recipe_.Get()),
+        recipeEndpoint_(this, this->recipe_, &DrawModel::OnRecipe_)
     {
 
     }
 
-    bool Contains(const tau::Point2d<double> &point)
+    DrawModel(const DrawModel &) = delete;
+    DrawModel & operator=(const DrawModel &) = delete;
+
+    bool Contains(const Point &point) const
     {
         return this->polygon_.Contains(point);
     }
 
+    const Polygon & GetPolygon() const
+    {
+        return this->polygon_;
+    }
+
+    RecipeControl GetRecipe()
+    {
+        return RecipeControl(this->recipe_);
+    }
+
+    ColorControl GetColor()
+    {
+        return ColorControl(this->color_);
+    }
+
+    void Draw(wxpex::GraphicsContext &graphics) const
+    {
+        FillPolygon(graphics, this->polygon_, this->color_.Get());
+    }
+
 private:
     void OnRecipe_(const Recipe &recipe)
     {
@@ -275,28 +545,32 @@ private:
     }
 
 private:
+    RecipeModel recipe_;
+    ColorModel color_;
+    Polygon polygon_;
     pex::Endpoint<DrawModel, RecipeControl> recipeEndpoint_;
 };
 
 
+// Polygons ordered from top to bottom.
 class Stack
 {
-    using List = std::list<DrawModel> models_;
+public:
+    using List = std::list<DrawModel>;
     using Iterator = typename List::iterator;
 
-public:
     Stack()
         :
-        models_()
+        models_(),
+        selected_()
     {
 
     }
 
-    bool Select(const tau::Point2d<double> &point)
+    // Selects the topmost polygon that contains point.
+    bool Select(const Point &point)
     {
-        auto it = this->models_.begin();
-
-        while (it != this->models_.end())
+        for (auto it = this->models_.begin(); it != this->models_.end(); ++it)
         {
             if (it->Contains(point))
             {
@@ -305,6 +579,8 @@ public:
             }
         }
 
+        this->selected_.reset();
+
         return false;
     }
 
@@ -316,25 +592,19 @@ public:
         }
 
         this->models_.erase(*this->selected_);
+        this->selected_.reset();
 
         return true;
     }
 
+    // Adds a polygon above the selected one, or on top, and selects it.
     void Add()
     {
-        if (this->selected_)
-        {
-            this->models_.emplace(*this->selected_);
+        auto position = this->selected_
+            ? *this->selected_
+            : this->models_.begin();
 
-            // Select the newly-added model.
-            --(*this->selected_);
-        }
-        else
-        {
-            // Place the new model on top.
-            this->models_.emplace(*this->models_.begin());
-            this->selected_ = this->models_.begin();
-        }
+        this->selected_ = this->models_.emplace(position);
     }
 
     std::optional<Iterator> GetSelected()
@@ -360,7 +630,7 @@ public:
 
         // Use splice to move the selected iterator one element closer to the
         // front.
-        this->models_.splice(previous, this->models_, this->selected_);
+        this->models_.splice(previous, this->models_, *this->selected_);
     }
 
     void LowerSelected()
@@ -370,27 +640,36 @@ public:
             return;
         }
 
-        if (*this->selected_ == this->models_.rbegin())
+        auto next = *this->selected_;
+        ++next;
+
+        if (next == this->models_.end())
         {
             // Already at the bottom
             return;
         }
 
-        auto next = *this->selected_;
         ++next;
 
-        // We should have already aborted if selected is the last item.
-        assert(next != this->models_.end());
-        ++next;
+        this->models_.splice(next, this->models_, *this->selected_);
+    }
 
-        this->models_.splice(next, this->models, this->selected_);
+    // Draws from the bottom up.
+    void Draw(wxpex::GraphicsContext &graphics) const
+    {
+        for (
+            auto it = this->models_.rbegin();
+            it != this->models_.rend();
+            ++it)
+        {
+            it->Draw(graphics);
+        }
     }
 
 private:
-    std::list<DrawModel> models_;
+    List models_;
     std::optional<Iterator> selected_;
 };
 
 
-
 } // end namespace polygon
@@ -28,6 +28,7 @@
 #include "wxpex/converter.h"
 #include "wxpex/style.h"
 #include "wxpex/async.h"
+#include "wxpex/startup_profiler.h"
 
 
 namespace wxpex
@@ -287,6 +288,7 @@ public:
         this->value_.Connect(&Slider::OnValue_);
         this->minimum_.Connect(&Slider::OnMinimum_);
         this->maximum_.Connect(&Slider::OnMaximum_);
+        PROFILE_WIDGET_CONNECTED(this)
 
         this->Bind(wxEVT_SLIDER, &Slider::OnSlider_, this);
         this->Bind(wxEVT_LEFT_DOWN, &Slider::OnSliderLeftDown_, this);
@@ -0,0 +1,443 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "wxpex/shape.h"
+
+
+namespace polygon
+{
+
+
+/**
+ ** A uniform grid over the bounding boxes of polygons, so that hit-testing a
+ ** point only tests the polygons that share its cell.
+ **
+ ** Each polygon is listed in every cell its bounding box overlaps. Choose a
+ ** cell size near the size of a typical polygon: much smaller cells list
+ ** each polygon many times, and much larger cells hold many candidates.
+ **
+ ** A polygon whose bounding box covers more than maximumCellCount cells is
+ ** kept in a separate list that every query checks, instead of being listed
+ ** in each cell. Cell indices are limited to +/- cellLimit, so every cell has
+ ** a distinct key.
+ **
+ ** Ids increase with each insertion, and Pick treats later polygons as being
+ ** on top, matching the order they would be drawn.
+ **
+ ** Bounds must be finite. Insert, Update, and QueryBounds throw
+ ** std::invalid_argument otherwise.
+ **/
+class SpatialIndex
+{
+public:
+    using Id = size_t;
+
+    static constexpr double defaultCellSize = 64.0;
+    static constexpr int64_t maximumCellCount = 1024;
+    static constexpr int64_t cellLimit = (int64_t(1) << 30);
+
+    SpatialIndex(double cellSize = defaultCellSize)
+        :
+        cellSize_(cellSize),
+        nextId_(0),
+        entries_(),
+        cells_(),
+        oversized_()
+    {
+        if (!(cellSize > 0.0))
+        {
+            throw std::invalid_argument("cellSize must be positive");
+        }
+    }
+
+    Id Insert(const Polygon &polygon)
+    {
+        auto cells = this->GetCells_(polygon.GetBounds());
+        auto id = this->nextId_++;
+        auto &entry = this->entries_[id];
+        entry.polygon = polygon;
+        entry.cells = cells;
+        this->Place_(id, cells);
+
+        return id;
+    }
+
+    void Remove(Id id)
+    {
+        auto &entry = this->GetEntry_(id);
+        this->Unplace_(id, entry.cells);
+        this->entries_.erase(id);
+    }
+
+    // Replace the polygon, keeping its id and its place in the stacking order.
+    void Update(Id id, const Polygon &polygon)
+    {
+        auto &entry = this->GetEntry_(id);
+        auto cells = this->GetCells_(polygon.GetBounds());
+
+        if (!(cells == entry.cells))
+        {
+            this->Unplace_(id, entry.cells);
+            this->Place_(id, cells);
+            entry.cells = cells;
+        }
+
+        entry.polygon = polygon;
+    }
+
+    const Polygon & Get(Id id) const
+    {
+        return this->GetEntry_(id).polygon;
+    }
+
+    size_t GetCount() const
+    {
+        return this->entries_.size();
+    }
+
+    void Clear()
+    {
+        this->entries_.clear();
+        this->cells_.clear();
+        this->oversized_.clear();
+    }
+
+    // Returns the topmost polygon that contains point.
+    std::optional<Id> Pick(const Point &point) const
+    {
+        std::optional<Id> result;
+
+        this->VisitCell_(
+            point,
+            [&result, &point, this](Id id) -> void
+            {
+                if (result && *result > id)
+                {
+                    return;
+                }
+
+                if (this->entries_.at(id).polygon.Contains(point))
+                {
+                    result = id;
+                }
+            });
+
+        return result;
+    }
+
+    // Returns every polygon that contains point, in no particular order.
+    std::vector<Id> QueryPoint(const Point &point) const
+    {
+        std::vector<Id> result;
+
+        this->VisitCell_(
+            point,
+            [&result, &point, this](Id id) -> void
+            {
+                if (this->entries_.at(id).polygon.Contains(point))
+                {
+                    result.push_back(id);
+                }
+            });
+
+        return result;
+    }
+
+    /**
+     ** Returns every polygon whose bounding box intersects bounds, in no
+     ** particular order.
+     **/
+    std::vector<Id> QueryBounds(const Bounds &bounds) const
+    {
+        std::vector<Id> result;
+        auto cells = this->GetCells_(bounds);
+
+        auto visitCell = [&](int64_t x, int64_t y, const std::vector<Id> &ids)
+        {
+            for (auto id: ids)
+            {
+                if (!this->entries_.at(id).polygon.GetBounds()
+                        .Intersects(bounds))
+                {
+                    continue;
+                }
+
+                // A polygon is listed in every cell it overlaps. Report it
+                // only from the first of those cells within the query.
+                auto &polygonCells = this->entries_.at(id).cells;
+
+                if (
+                    std::max(polygonCells.left, cells.left) == x
+                    && std::max(polygonCells.top, cells.top) == y)
+                {
+                    result.push_back(id);
+                }
+            }
+        };
+
+        if (cells.GetCount() > static_cast<int64_t>(this->cells_.size()))
+        {
+            // Fewer cells are occupied than the query covers.
+            for (auto &[key, ids]: this->cells_)
+            {
+                auto [x, y] = SplitCellKey_(key);
+
+                if (
+                    x >= cells.left && x <= cells.right
+                    && y >= cells.top && y <= cells.bottom)
+                {
+                    visitCell(x, y, ids);
+                }
+            }
+        }
+        else
+        {
+            for (auto y = cells.top; y <= cells.bottom; ++y)
+            {
+                for (auto x = cells.left; x <= cells.right; ++x)
+                {
+                    auto found = this->cells_.find(MakeCellKey_(x, y));
+
+                    if (found != this->cells_.end())
+                    {
+                        visitCell(x, y, found->second);
+                    }
+                }
+            }
+        }
+
+        for (auto id: this->oversized_)
+        {
+            if (this->entries_.at(id).polygon.GetBounds().Intersects(bounds))
+            {
+                result.push_back(id);
+            }
+        }
+
+        return result;
+    }
+
+private:
+    struct Cells_
+    {
+        int64_t left;
+        int64_t top;
+        int64_t right;
+        int64_t bottom;
+
+        bool operator==(const Cells_ &other) const
+        {
+            return this->left == other.left
+                && this->top == other.top
+                && this->right == other.right
+                && this->bottom == other.bottom;
+        }
+
+        // At most (2 * cellLimit + 1)^2, which fits in 63 bits.
+        int64_t GetCount() const
+        {
+            return (this->right - this->left + 1)
+                * (this->bottom - this->top + 1);
+        }
+
+        bool IsOversized() const
+        {
+            return this->GetCount() > maximumCellCount;
+        }
+    };
+
+    struct Entry_
+    {
+        Polygon polygon;
+        Cells_ cells;
+    };
+
+    using CellKey = uint64_t;
+
+    // Cells are within cellLimit, so each fits in 32 bits without loss.
+    static CellKey MakeCellKey_(int64_t x, int64_t y)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32)
+            | static_cast<uint64_t>(static_cast<uint32_t>(y));
+    }
+
+    static std::pair<int64_t, int64_t> SplitCellKey_(CellKey key)
+    {
+        return {
+            static_cast<int32_t>(static_cast<uint32_t>(key >> 32)),
+            static_cast<int32_t>(static_cast<uint32_t>(key))};
+    }
+
+    // coordinate must be finite.
+    int64_t GetCell_(double coordinate) const
+    {
+        auto limit = static_cast<double>(cellLimit);
+        auto cell = std::floor(coordinate / this->cellSize_);
+
+        return static_cast<int64_t>(std::clamp(cell, -limit, limit));
+    }
+
+    Cells_ GetCells_(const Bounds &bounds) const
+    {
+        if (
+            !std::isfinite(bounds.left)
+            || !std::isfinite(bounds.top)
+            || !std::isfinite(bounds.right)
+            || !std::isfinite(bounds.bottom))
+        {
+            throw std::invalid_argument("SpatialIndex bounds must be finite");
+        }
+
+        return {
+            this->GetCell_(bounds.left),
+            this->GetCell_(bounds.top),
+            this->GetCell_(bounds.right),
+            this->GetCell_(bounds.bottom)};
+    }
+
+    void Place_(Id id, const Cells_ &cells)
+    {
+        if (cells.IsOversized())
+        {
+            this->oversized_.push_back(id);
+        }
+        else
+        {
+            this->AddToCells_(id, cells);
+        }
+    }
+
+    void Unplace_(Id id, const Cells_ &cells)
+    {
+        if (cells.IsOversized())
+        {
+            auto it =
+                std::find(this->oversized_.begin(), this->oversized_.end(), id);
+
+            if (it != this->oversized_.end())
+            {
+                *it = this->oversized_.back();
+                this->oversized_.pop_back();
+            }
+        }
+        else
+        {
+            this->RemoveFromCells_(id, cells);
+        }
+    }
+
+    void AddToCells_(Id id, const Cells_ &cells)
+    {
+        for (auto y = cells.top; y <= cells.bottom; ++y)
+        {
+            for (auto x = cells.left; x <= cells.right; ++x)
+            {
+                this->cells_[MakeCellKey_(x, y)].push_back(id);
+            }
+        }
+    }
+
+    void RemoveFromCells_(Id id, const Cells_ &cells)
+    {
+        for (auto y = cells.top; y <= cells.bottom; ++y)
+        {
+            for (auto x = cells.left; x <= cells.right; ++x)
+            {
+                auto found = this->cells_.find(MakeCellKey_(x, y));
+
+                if (found == this->cells_.end())
+                {
+                    continue;
+                }
+
+                auto &ids = found->second;
+
+                // Order within a cell does not matter.
+                auto it = std::find(ids.begin(), ids.end(), id);
+
+                if (it != ids.end())
+                {
+                    *it = ids.back();
+                    ids.pop_back();
+                }
+
+                if (ids.empty())
+                {
+                    this->cells_.erase(found);
+                }
+            }
+        }
+    }
+
+    // Visits the polygons listed in the cell of point, and the oversized
+    // polygons.
+    template<typename Visit>
+    void VisitCell_(const Point &point, Visit &&visit) const
+    {
+        if (!std::isfinite(point.x) || !std::isfinite(point.y))
+        {
+            // No polygon contains it.
+            return;
+        }
+
+        for (auto id: this->oversized_)
+        {
+            visit(id);
+        }
+
+        auto found = this->cells_.find(
+            MakeCellKey_(this->GetCell_(point.x), this->GetCell_(point.y)));
+
+        if (found == this->cells_.end())
+        {
+            return;
+        }
+
+        for (auto id: found->second)
+        {
+            visit(id);
+        }
+    }
+
+    Entry_ & GetEntry_(Id id)
+    {
+        auto found = this->entries_.find(id);
+
+        if (found == this->entries_.end())
+        {
+            throw std::out_of_range("Unknown SpatialIndex id");
+        }
+
+        return found->second;
+    }
+
+    const Entry_ & GetEntry_(Id id) const
+    {
+        auto found = this->entries_.find(id);
+
+        if (found == this->entries_.end())
+        {
+            throw std::out_of_range("Unknown SpatialIndex id");
+        }
+
+        return found->second;
+    }
+
+    double cellSize_;
+    Id nextId_;
+    std::unordered_map<Id, Entry_> entries_;
+    std::unordered_map<CellKey, std::vector<Id>> cells_;
+    std::vector<Id> oversized_;
+};
+
+
+} // end namespace polygon
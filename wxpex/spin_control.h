@@ -21,6 +21,8 @@ WXSHIM_POP_IGNORES
 #include <pex/range.h>
 #include <jive/to_float.h>
 
+#include "wxpex/startup_profiler.h"
+
 
 namespace wxpex
 {
@@ -67,6 +69,7 @@ public:
         this->value_.Connect(&SpinControl::OnValue_);
         this->minimum_.Connect(&SpinControl::OnMinimum_);
         this->maximum_.Connect(&SpinControl::OnMaximum_);
+        PROFILE_WIDGET_CONNECTED(this)
 
         this->Bind(
             wxEVT_SPINCTRLDOUBLE,
@@ -0,0 +1,365 @@
+#include "wxpex/startup_profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <vector>
+
+#include "wxpex/widget_names.h"
+
+
+namespace wxpex
+{
+
+
+namespace
+{
+
+
+struct Record
+{
+    StartupProfiler::Duration construction{};
+    std::optional<StartupProfiler::Duration> registered;
+    std::optional<StartupProfiler::Duration> connected;
+    std::optional<StartupProfiler::Duration> firstLayout;
+    std::optional<StartupProfiler::Duration> firstPaint;
+};
+
+
+struct Profile
+{
+    bool isEnabled = false;
+    StartupProfiler::Clock::time_point start;
+    StartupProfiler::Clock::time_point lastRegistration;
+    std::map<wxWindow *, Record> records;
+};
+
+
+Profile profile_;
+
+
+StartupProfiler::Duration Elapsed()
+{
+    return StartupProfiler::Clock::now() - profile_.start;
+}
+
+
+void OnFirstSize(wxSizeEvent &event);
+void OnFirstPaint(wxPaintEvent &event);
+
+
+void OnDestroy(wxWindowDestroyEvent &event)
+{
+    event.Skip();
+
+    // The event is only sent to the window being destroyed. Its children
+    // receive their own.
+    profile_.records.erase(event.GetWindow());
+}
+
+
+Record & GetRecord(wxWindow *window)
+{
+    auto found = profile_.records.find(window);
+
+    if (found != profile_.records.end())
+    {
+        return found->second;
+    }
+
+    window->Bind(wxEVT_SIZE, &OnFirstSize);
+    window->Bind(wxEVT_PAINT, &OnFirstPaint);
+    window->Bind(wxEVT_DESTROY, &OnDestroy);
+
+    return profile_.records[window];
+}
+
+
+void OnFirstSize(wxSizeEvent &event)
+{
+    event.Skip();
+
+    auto window = dynamic_cast<wxWindow *>(event.GetEventObject());
+    window->Unbind(wxEVT_SIZE, &OnFirstSize);
+
+    auto found = profile_.records.find(window);
+
+    if (found != profile_.records.end() && !found->second.firstLayout)
+    {
+        found->second.firstLayout = Elapsed();
+    }
+}
+
+
+void OnFirstPaint(wxPaintEvent &event)
+{
+    // Skip so that the window's own handlers and the native control still
+    // paint.
+    event.Skip();
+
+    auto window = dynamic_cast<wxWindow *>(event.GetEventObject());
+    window->Unbind(wxEVT_PAINT, &OnFirstPaint);
+
+    auto found = profile_.records.find(window);
+
+    if (found != profile_.records.end() && !found->second.firstPaint)
+    {
+        found->second.firstPaint = Elapsed();
+    }
+}
+
+
+// Profiled ancestors of window, outermost first, ending with window.
+std::vector<wxWindow *> GetProfiledAncestry(wxWindow *window)
+{
+    std::vector<wxWindow *> result;
+
+    for (; window; window = window->GetParent())
+    {
+        auto found = profile_.records.find(window);
+
+        if (found != profile_.records.end() && found->second.registered)
+        {
+            result.push_back(window);
+        }
+    }
+
+    std::reverse(result.begin(), result.end());
+
+    return result;
+}
+
+
+std::string GetFrameName(wxWindow *window)
+{
+    auto name = GetWidgetName(window);
+
+    // ';' separates frames, and ' ' separates the stack from its value.
+    std::replace(name.begin(), name.end(), ';', ':');
+    std::replace(name.begin(), name.end(), ' ', '_');
+
+    return name;
+}
+
+
+void WriteTime(
+    std::ostream &output,
+    const std::optional<StartupProfiler::Duration> &time)
+{
+    output << std::setw(10);
+
+    if (time)
+    {
+        output << time->count();
+    }
+    else
+    {
+        output << "-";
+    }
+}
+
+
+} // end anonymous namespace
+
+
+void StartupProfiler::Enable()
+{
+    profile_.records.clear();
+    profile_.start = Clock::now();
+    profile_.lastRegistration = profile_.start;
+    profile_.isEnabled = true;
+}
+
+
+void StartupProfiler::Disable()
+{
+    for (auto &it: profile_.records)
+    {
+        auto window = it.first;
+        window->Unbind(wxEVT_SIZE, &OnFirstSize);
+        window->Unbind(wxEVT_PAINT, &OnFirstPaint);
+        window->Unbind(wxEVT_DESTROY, &OnDestroy);
+    }
+
+    profile_.records.clear();
+    profile_.isEnabled = false;
+}
+
+
+bool StartupProfiler::IsEnabled()
+{
+    return profile_.isEnabled;
+}
+
+
+void StartupProfiler::MarkRegistered(wxWindow *window)
+{
+    if (!profile_.isEnabled)
+    {
+        return;
+    }
+
+    auto now = Clock::now();
+    auto &record = GetRecord(window);
+
+    // A widget may be registered more than once, for example by its own
+    // constructor and again by its parent. Charge both to the same widget.
+    record.construction += now - profile_.lastRegistration;
+
+    if (!record.registered)
+    {
+        record.registered = now - profile_.start;
+    }
+
+    profile_.lastRegistration = now;
+}
+
+
+void StartupProfiler::MarkConnected(wxWindow *window)
+{
+    if (!profile_.isEnabled)
+    {
+        return;
+    }
+
+    auto &record = GetRecord(window);
+
+    if (!record.connected)
+    {
+        record.connected = Elapsed();
+    }
+}
+
+
+std::ostream & StartupProfiler::WriteReport(std::ostream &output)
+{
+    // Sum the construction cost of each subtree, and collect children in
+    // registration order.
+    std::map<wxWindow *, Duration> subtree;
+    std::map<wxWindow *, std::vector<wxWindow *>> children;
+    std::vector<wxWindow *> roots;
+
+    std::vector<std::pair<Duration, wxWindow *>> ordered;
+
+    for (auto &[window, record]: profile_.records)
+    {
+        if (record.registered)
+        {
+            ordered.emplace_back(*record.registered, window);
+        }
+    }
+
+    std::sort(
+        ordered.begin(),
+        ordered.end(),
+        [](const auto &left, const auto &right) -> bool
+        {
+            return left.first < right.first;
+        });
+
+    for (auto &entry: ordered)
+    {
+        auto window = entry.second;
+        auto ancestry = GetProfiledAncestry(window);
+        auto construction = profile_.records[window].construction;
+
+        for (auto ancestor: ancestry)
+        {
+            subtree[ancestor] += construction;
+        }
+
+        if (ancestry.size() < 2)
+        {
+            roots.push_back(window);
+        }
+        else
+        {
+            children[ancestry[ancestry.size() - 2]].push_back(window);
+        }
+    }
+
+    output << std::fixed << std::setprecision(3);
+
+    output << std::setw(10) << "total"
+        << std::setw(10) << "self"
+        << std::setw(10) << "built"
+        << std::setw(10) << "connected"
+        << std::setw(10) << "layout"
+        << std::setw(10) << "paint"
+        << "  widget (ms since Enable)\n";
+
+    std::vector<std::pair<wxWindow *, size_t>> stack;
+
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+    {
+        stack.emplace_back(*it, 0);
+    }
+
+    while (!stack.empty())
+    {
+        auto [window, depth] = stack.back();
+        stack.pop_back();
+
+        const auto &record = profile_.records[window];
+
+        output << std::setw(10) << subtree[window].count()
+            << std::setw(10) << record.construction.count();
+
+        WriteTime(output, record.registered);
+        WriteTime(output, record.connected);
+        WriteTime(output, record.firstLayout);
+        WriteTime(output, record.firstPaint);
+
+        output << "  " << std::string(depth * 2, ' ')
+            << GetWidgetName(window) << '\n';
+
+        auto &windowChildren = children[window];
+
+        for (
+            auto it = windowChildren.rbegin();
+            it != windowChildren.rend();
+            ++it)
+        {
+            stack.emplace_back(*it, depth + 1);
+        }
+    }
+
+    return output;
+}
+
+
+std::ostream & StartupProfiler::WriteFoldedStacks(std::ostream &output)
+{
+    for (auto &[window, record]: profile_.records)
+    {
+        if (!record.registered)
+        {
+            continue;
+        }
+
+        auto ancestry = GetProfiledAncestry(window);
+        bool isFirst = true;
+
+        for (auto ancestor: ancestry)
+        {
+            if (!isFirst)
+            {
+                output << ';';
+            }
+
+            output << GetFrameName(ancestor);
+            isFirst = false;
+        }
+
+        auto microseconds =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                record.construction);
+
+        output << ' ' << microseconds.count() << '\n';
+    }
+
+    return output;
+}
+
+
+} // end namespace wxpex
@@ -0,0 +1,87 @@
+#pragma once
+
+
+#include <chrono>
+#include <optional>
+#include <ostream>
+#include <string>
+
+#include "wxpex/wxshim.h"
+
+
+namespace wxpex
+{
+
+
+/**
+ ** Records where startup time goes, keyed by the names given to
+ ** RegisterWidgetName.
+ **
+ ** Construction cost is attributed by registration order: the time elapsed
+ ** since the previous registration is charged to the widget being registered.
+ ** This is the widget's own cost when it registers at the end of its
+ ** constructor, after its children. A widget that registers earlier, as
+ ** Collapsible does before its pane has content, is charged for the work that
+ ** came before it, and the rest of its construction is charged to the next
+ ** widget to register. The self column is only as precise as the placement
+ ** of registrations.
+ **
+ ** The cost of a subtree, in the report and the folded stacks, is the sum of
+ ** the costs of its registered members. Subtree totals leak across sibling
+ ** boundaries: work done after the last registration within a subtree is
+ ** charged to the next widget to register, which is often a sibling outside
+ ** of it, and the subtree is undercharged by the same amount.
+ **
+ ** The first layout (first size event) and the first paint of each registered
+ ** widget are also recorded, along with pex endpoint connections reported by
+ ** MarkConnected.
+ **
+ ** The profiler is off by default. While disabled, registration only pays for
+ ** a flag check.
+ **
+ ** Must only be used from the wx event loop thread.
+ **/
+class StartupProfiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Duration = std::chrono::duration<double, std::milli>;
+
+    // Start recording. Times are reported relative to this call.
+    static void Enable();
+
+    // Stop recording, and discard everything that has been recorded.
+    static void Disable();
+
+    static bool IsEnabled();
+
+    static void MarkRegistered(wxWindow *window);
+
+    static void MarkConnected(wxWindow *window);
+
+    /**
+     ** Writes the registered widgets as an indented tree, with self and
+     ** subtree construction cost, and the time of each recorded event.
+     **/
+    static std::ostream & WriteReport(std::ostream &output);
+
+    /**
+     ** Writes the construction cost of each widget in the folded stack format
+     ** consumed by flamegraph.pl, speedscope, and similar tools:
+     **
+     **     frame;panel;knob 1250
+     **
+     ** Values are in microseconds.
+     **/
+    static std::ostream & WriteFoldedStacks(std::ostream &output);
+};
+
+
+} // end namespace wxpex
+
+
+#define PROFILE_WIDGET_CONNECTED(window) \
+    if (wxpex::StartupProfiler::IsEnabled()) \
+    { \
+        wxpex::StartupProfiler::MarkConnected(window); \
+    }
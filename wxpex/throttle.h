@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+#include <pex/argument.h>
+
+#include "wxpex/refresh_timer.h"
+
+
+namespace wxpex
+{
+
+
+class ReadoutSettings
+{
+public:
+    ReadoutSettings()
+        :
+        maximumRate(0.0),
+        trailingEdge(true),
+        showExtrema(false)
+    {
+
+    }
+
+    // All setting functions return a reference to this instance so they can be
+    // chained.
+    //
+    // settings.MaximumRate(30).ShowExtrema(true);
+
+    /**
+     ** The maximum number of refreshes per second.
+     ** A rate of zero (the default) applies every value as it arrives.
+     ** Rates above 1000 are limited to one refresh per millisecond.
+     **/
+    ReadoutSettings & MaximumRate(double value)
+    {
+        this->maximumRate = value;
+        return *this;
+    }
+
+    /**
+     ** Values that arrive faster than the maximum rate are held until the next
+     ** tick of the shared RefreshTimer, guaranteeing that the newest value is
+     ** always displayed.
+     **
+     ** Without the trailing edge, no timer is used. A held value is only
+     ** displayed when another value arrives after the refresh interval, so
+     ** the display may lag when the source stops changing.
+     **/
+    ReadoutSettings & TrailingEdge(bool value)
+    {
+        this->trailingEdge = value;
+        return *this;
+    }
+
+    /**
+     ** Display the minimum and maximum of all values received since the last
+     ** refresh alongside the newest value.
+     ** Only applies to arithmetic types.
+     **/
+    ReadoutSettings & ShowExtrema(bool value)
+    {
+        this->showExtrema = value;
+        return *this;
+    }
+
+    bool IsLimited() const
+    {
+        return this->maximumRate > 0.0;
+    }
+
+    int GetInterval_ms() const
+    {
+        // A zero interval would make the timer fire continuously.
+        return std::max(
+            1,
+            static_cast<int>(std::round(1000.0 / this->maximumRate)));
+    }
+
+    double maximumRate;
+    bool trailingEdge;
+    bool showExtrema;
+};
+
+
+template<typename T>
+struct Readout
+{
+    // The newest value.
+    T value;
+
+    // The extrema of all values received since the last refresh.
+    // Equal to value for non-arithmetic types.
+    T minimum;
+    T maximum;
+
+    // The number of values received since the last refresh.
+    size_t count;
+};
+
+
+/**
+ ** Coalesces values that arrive faster than ReadoutSettings::maximumRate.
+ **
+ ** A value that arrives after the refresh interval has elapsed is applied
+ ** immediately. Values that arrive within the interval are held, and the
+ ** newest is applied on the next tick of the shared RefreshTimer.
+ **
+ ** Must only be used from the wx event loop thread.
+ **/
+template<typename T>
+class Throttle
+{
+public:
+    using Apply = std::function<void(const Readout<T> &)>;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr bool hasExtrema = std::is_arithmetic_v<T>;
+
+    Throttle(const ReadoutSettings &settings, const Apply &apply)
+        :
+        settings_(settings),
+        apply_(apply),
+        interval_(),
+        timer_(),
+        readout_(),
+        hasPending_(false),
+        isScheduled_(false),
+        lastRefresh_()
+    {
+        if (!this->settings_.IsLimited())
+        {
+            return;
+        }
+
+        this->interval_ =
+            std::chrono::milliseconds(this->settings_.GetInterval_ms());
+
+        if (this->settings_.trailingEdge)
+        {
+            this->timer_ =
+                RefreshTimer::Acquire(this->settings_.GetInterval_ms());
+        }
+    }
+
+    ~Throttle()
+    {
+        if (this->timer_)
+        {
+            this->timer_->Cancel(this);
+        }
+    }
+
+    Throttle(const Throttle &) = delete;
+    Throttle & operator=(const Throttle &) = delete;
+
+    const ReadoutSettings & GetSettings() const
+    {
+        return this->settings_;
+    }
+
+    void Update(pex::Argument<T> value)
+    {
+        if (!this->settings_.IsLimited())
+        {
+            this->apply_(Readout<T>{value, value, value, 1});
+            return;
+        }
+
+        this->Accumulate_(value);
+
+        if (this->isScheduled_)
+        {
+            // The next tick will apply the newest value.
+            return;
+        }
+
+        if (Clock::now() - this->lastRefresh_ >= this->interval_)
+        {
+            // Leading edge.
+            this->Refresh_();
+            return;
+        }
+
+        if (this->timer_)
+        {
+            this->isScheduled_ = true;
+
+            this->timer_->Request(
+                this,
+                [this]() -> void
+                {
+                    this->OnTick_();
+                });
+        }
+    }
+
+private:
+    void Accumulate_(pex::Argument<T> value)
+    {
+        if (!this->hasPending_)
+        {
+            this->readout_ = Readout<T>{value, value, value, 1};
+            this->hasPending_ = true;
+
+            return;
+        }
+
+        this->readout_.value = value;
+        ++this->readout_.count;
+
+        if constexpr (hasExtrema)
+        {
+            if (value < this->readout_.minimum)
+            {
+                this->readout_.minimum = value;
+            }
+
+            if (value > this->readout_.maximum)
+            {
+                this->readout_.maximum = value;
+            }
+        }
+        else
+        {
+            this->readout_.minimum = value;
+            this->readout_.maximum = value;
+        }
+    }
+
+    void OnTick_()
+    {
+        this->isScheduled_ = false;
+
+        if (this->hasPending_)
+        {
+            this->Refresh_();
+        }
+    }
+
+    void Refresh_()
+    {
+        this->hasPending_ = false;
+        this->lastRefresh_ = Clock::now();
+        this->apply_(this->readout_);
+    }
+
+private:
+    ReadoutSettings settings_;
+    Apply apply_;
+    Clock::duration interval_;
+    std::shared_ptr<RefreshTimer> timer_;
+    Readout<T> readout_;
+    bool hasPending_;
+    bool isScheduled_;
+    Clock::time_point lastRefresh_;
+};
+
+
+} // end namespace wxpex
@@ -11,12 +11,15 @@
 
 #pragma once
 
+#include <functional>
 #include <type_traits>
 #include <string>
 
 #include <pex/value.h>
 #include <pex/argument.h>
 #include <wxpex/converter.h>
+#include <wxpex/throttle.h>
+#include <wxpex/startup_profiler.h>
 
 #include "wxpex/wxshim.h"
 
@@ -43,6 +46,23 @@ public:
         Control value,
         long style = 0)
         :
+        View(parent, value, ReadoutSettings(), style)
+    {
+
+    }
+
+    /**
+     ** A View that limits how often its label is refreshed.
+     **
+     ** Intermediate values are held, and only the newest is displayed when
+     ** the shared RefreshTimer ticks. See ReadoutSettings.
+     **/
+    View(
+        wxWindow *parent,
+        Control value,
+        const ReadoutSettings &readoutSettings,
+        long style = 0)
+        :
         Base(
             parent,
             wxID_ANY,
@@ -50,25 +70,71 @@ public:
             wxDefaultPosition,
             wxDefaultSize,
             style),
-        value_(USE_REGISTER_PEX_NAME(this, "wxpex::View"), value)
+        value_(USE_REGISTER_PEX_NAME(this, "wxpex::View"), value),
+        onRefresh_(),
+        throttle_(
+            readoutSettings,
+            [this](const Readout<Type> &readout) -> void
+            {
+                this->OnReadout_(readout);
+            })
     {
         this->value_.Connect(&View::OnValueChanged_);
+        PROFILE_WIDGET_CONNECTED(this)
+    }
+
+    /**
+     ** Called after each refresh of the label, on the same tick, so that a
+     ** parent can lay out around the new size without a throttle of its own.
+     **/
+    void SetOnRefresh(const std::function<void()> &onRefresh)
+    {
+        this->onRefresh_ = onRefresh;
     }
 
 private:
     void OnValueChanged_(pex::Argument<Type> value)
     {
-        this->SetLabel(Convert::ToString(value));
+        this->throttle_.Update(value);
+    }
+
+    void OnReadout_(const Readout<Type> &readout)
+    {
+        this->SetLabel(this->FormatReadout_(readout));
         this->UpdateMinimumSize_();
+
+        if (this->onRefresh_)
+        {
+            this->onRefresh_();
+        }
+    }
+
+    wxString FormatReadout_(const Readout<Type> &readout) const
+    {
+        // Convert may produce either std::string or wxString.
+        wxString result(Convert::ToString(readout.value));
+
+        if constexpr (Throttle<Type>::hasExtrema)
+        {
+            if (
+                this->throttle_.GetSettings().showExtrema
+                && readout.count > 1)
+            {
+                result
+                    << " [" << wxString(Convert::ToString(readout.minimum))
+                    << ", " << wxString(Convert::ToString(readout.maximum))
+                    << "]";
+            }
+        }
+
+        return result;
     }
 
     void UpdateMinimumSize_()
     {
         // Text entry field should resize to fit whatever text is displayed.
         auto fittingSize =
-            this->GetSizeFromTextSize(
-                this->GetTextExtent(
-                    Convert::ToString(this->value_.Get())));
+            this->GetSizeFromTextSize(this->GetTextExtent(this->GetLabel()));
 
         this->SetMinClientSize(fittingSize);
         this->InvalidateBestSize();
@@ -76,6 +142,8 @@ private:
 
     using Value_ = pex::Terminus<View, Control>;
     Value_ value_;
+    std::function<void()> onRefresh_;
+    Throttle<Type> throttle_;
 };
 
 
@@ -90,6 +158,21 @@ View<Value, Convert> * MakeView(wxWindow *parent, Value value, long style = 0)
 }
 
 
+template
+<
+    typename Value,
+    typename Convert = pex::Converter<typename Value::Type>
+>
+View<Value, Convert> * MakeView(
+    wxWindow *parent,
+    Value value,
+    const ReadoutSettings &readoutSettings,
+    long style = 0)
+{
+    return new View<Value, Convert>(parent, value, readoutSettings, style);
+}
+
+
 template<int precision, typename Control>
 auto CreateView(wxWindow *parent, Control control)
 {
@@ -99,4 +182,16 @@ auto CreateView(wxWindow *parent, Control control)
 }
 
 
+template<int precision, typename Control>
+auto CreateView(
+    wxWindow *parent,
+    Control control,
+    const ReadoutSettings &readoutSettings)
+{
+    using Result = View<Control, PrecisionConverter<Control, precision>>;
+
+    return new Result(parent, control, readoutSettings);
+}
+
+
 } // namespace wxpex
@@ -1,29 +1,117 @@
 #include "wxpex/widget_names.h"
-#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include "wxpex/startup_profiler.h"
 
 
 namespace wxpex
 {
 
 
-static std::map<wxWindow *, std::string> nameByPointer_;
+namespace
+{
+
+
+class WidgetNames
+{
+public:
+    void Register(wxWindow *window, const std::string &name)
+    {
+        std::unique_lock lock(this->mutex_);
+
+        // Many widgets share a name. Store each name once.
+        auto interned = &*this->names_.insert(name).first;
+        auto [it, isNew] = this->nameByPointer_.try_emplace(window, interned);
+
+        if (!isNew)
+        {
+            // Renamed. The destroy handler is already bound.
+            it->second = interned;
+
+            return;
+        }
+
+        lock.unlock();
+
+        // Remove the entry when the window is destroyed, so that the registry
+        // does not grow without bound, and a new window that reuses the
+        // address does not inherit the name.
+        window->Bind(wxEVT_DESTROY, &WidgetNames::OnDestroy_);
+    }
+
+    std::string Get(wxWindow *window) const
+    {
+        std::shared_lock lock(this->mutex_);
+
+        auto found = this->nameByPointer_.find(window);
+
+        if (found == this->nameByPointer_.end())
+        {
+            return "None";
+        }
+
+        return *found->second;
+    }
+
+    void Remove(wxWindow *window)
+    {
+        std::unique_lock lock(this->mutex_);
+        this->nameByPointer_.erase(window);
+    }
 
+    size_t GetCount() const
+    {
+        std::shared_lock lock(this->mutex_);
+
+        return this->nameByPointer_.size();
+    }
+
+private:
+    static void OnDestroy_(wxWindowDestroyEvent &event);
+
+    mutable std::shared_mutex mutex_;
+
+    // Elements of an unordered_set are never moved, so pointers to them
+    // remain valid as names are added.
+    std::unordered_set<std::string> names_;
+    std::unordered_map<wxWindow *, const std::string *> nameByPointer_;
+};
+
+
+WidgetNames widgetNames_;
+
+
+void WidgetNames::OnDestroy_(wxWindowDestroyEvent &event)
+{
+    event.Skip();
+
+    // wxEVT_DESTROY is sent to each window that is destroyed, including
+    // children.
+    widgetNames_.Remove(event.GetWindow());
+}
+
+
+} // end anonymous namespace
 
 
 void RegisterWidgetName(wxWindow *window, const std::string &name)
 {
-    nameByPointer_[window] = name;
+    widgetNames_.Register(window, name);
+    StartupProfiler::MarkRegistered(window);
 }
 
 
 std::string GetWidgetName(wxWindow *window)
 {
-    if (nameByPointer_.count(window) == 1)
-    {
-        return nameByPointer_[window];
-    }
+    return widgetNames_.Get(window);
+}
 
-    return "None";
+
+size_t GetRegisteredWidgetCount()
+{
+    return widgetNames_.GetCount();
 }
 
 
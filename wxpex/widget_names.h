@@ -10,10 +10,19 @@ namespace wxpex
 {
 
 
+/**
+ ** Names are removed automatically when the window is destroyed.
+ **
+ ** Lookups are thread-safe. Registration must happen on the wx event loop
+ ** thread, where the window is created.
+ **/
 void RegisterWidgetName(wxWindow *window, const std::string &name);
 
+// Returns "None" for windows that have not been registered.
 std::string GetWidgetName(wxWindow *window);
 
+size_t GetRegisteredWidgetCount();
+
 std::vector<std::string> GetAncestry(wxWindow *window);
 
 std::ostream & PrintAncestry(
@@ -37,7 +46,9 @@ wxWindow * MakeWidget(
 } // end namespace wxpex
 
 
-#ifndef NDEBUG
+// Widget names are registered in debug builds. Define WXPEX_WIDGET_NAMES
+// (see the CMake option of the same name) to register them in release builds.
+#if !defined(NDEBUG) || defined(WXPEX_WIDGET_NAMES)
 #define REGISTER_WIDGET_NAME(window, name) \
     wxpex::RegisterWidgetName(window, name);
 #else